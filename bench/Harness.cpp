@@ -0,0 +1,255 @@
+﻿// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co.,Ltd.
+
+#include "Interpreter.h" // for Interpreter, MemoryResourceKind,
+//	TrackingResource, LoadStandardLibrary, Context, string_view;
+#include <vector> // for std::vector;
+#include <string> // for std::string;
+#include <fstream> // for std::ifstream, std::ofstream;
+#include <sstream> // for std::ostringstream;
+#include <stdexcept> // for std::invalid_argument;
+#include <chrono> // for std::chrono::steady_clock, std::chrono::duration;
+#include <algorithm> // for std::min_element;
+#include <numeric> // for std::accumulate;
+#include <cstdio> // for std::snprintf;
+#include <cstdlib> // for std::strtoul, EXIT_FAILURE, EXIT_SUCCESS;
+#include <iostream> // for std::cout, std::clog;
+#include <ystdex/scope_guard.hpp> // for ystdex::make_guard;
+#include <YSLib/Core/YModules.h>
+#include YFM_YSLib_Core_YException // for YSLib::FilterExceptions,
+//	YSLib::Alert;
+
+namespace Unilang
+{
+
+namespace
+{
+
+struct WorkloadResult final
+{
+	std::string Name;
+	std::vector<double> Times{};
+	size_t TailActions = 0;
+	size_t Allocations = 0;
+	size_t AllocatedBytes = 0;
+	size_t ResolutionCacheHits = 0;
+	size_t ResolutionCacheMisses = 0;
+	size_t CompressedFrameRecords = 0;
+	size_t MaxFrameRecords = 0;
+};
+
+YB_ATTR_nodiscard std::string
+ReadUnit(const std::string& path)
+{
+	std::ifstream ifs(path, std::ios_base::in | std::ios_base::binary);
+
+	if(ifs)
+	{
+		std::ostringstream oss;
+
+		oss << ifs.rdbuf();
+
+		auto str(oss.str());
+
+		// NOTE: Skip the UTF-8 BOM, as the interpreter does for the files.
+		if(str.compare(0, 3, "\xEF\xBB\xBF") == 0)
+			str.erase(0, 3);
+		return str;
+	}
+	throw std::invalid_argument("Failed opening workload '" + path + "'.");
+}
+
+YB_ATTR_nodiscard WorkloadResult
+RunWorkload(const std::string& path, size_t warmup, size_t repeat, int& argc,
+	char* argv[])
+{
+	using clock = std::chrono::steady_clock;
+	// NOTE: The tracking resource counts the allocations of the interpreter.
+	Interpreter intp(MemoryResourceKind::Tracking);
+
+	LoadStandardLibrary(intp, argc, argv);
+
+	const auto unit(ReadUnit(path));
+	const auto& rsrc(dynamic_cast<const TrackingResource&>(
+		intp.GetMemoryResourceRef()));
+	WorkloadResult res;
+
+	res.Name = path;
+	for(size_t i(0); i != warmup; ++i)
+		yunused(intp.Perform(unit));
+	for(size_t i(0); i != repeat; ++i)
+	{
+		const auto start(clock::now());
+
+		yunused(intp.Perform(unit));
+		res.Times.push_back(std::chrono::duration<double, std::milli>(
+			clock::now() - start).count());
+	}
+
+	// NOTE: The counts are from an additional run, so the timing is not
+	//	affected by the counting.
+	const auto allocs(rsrc.AllocationCount);
+	const auto bytes(rsrc.AllocatedBytes);
+	const auto hits(intp.Main.ResolutionCacheHits);
+	const auto misses(intp.Main.ResolutionCacheMisses);
+	const auto compressed(intp.Main.CompressedFrameRecords);
+	size_t n_tail(0);
+	// NOTE: The previous tracer (e.g. the sampling profiler enabled by
+	//	%UNILANG_PROFILE) is still called, and it is restored after the run.
+	auto trace(intp.Main.TraceTail);
+	const auto gd(ystdex::make_guard([&]() noexcept{
+		intp.Main.TraceTail = std::move(trace);
+	}));
+
+	intp.Main.MaxFrameRecords = 0;
+	intp.Main.TraceTail = [&](const Context& ctx){
+		if(trace)
+			trace(ctx);
+		++n_tail;
+	};
+	yunused(intp.Perform(unit));
+	res.TailActions = n_tail;
+	res.Allocations = rsrc.AllocationCount - allocs;
+	res.AllocatedBytes = rsrc.AllocatedBytes - bytes;
+	res.ResolutionCacheHits = intp.Main.ResolutionCacheHits - hits;
+	res.ResolutionCacheMisses = intp.Main.ResolutionCacheMisses - misses;
+	res.CompressedFrameRecords
+		= intp.Main.CompressedFrameRecords - compressed;
+	res.MaxFrameRecords = intp.Main.MaxFrameRecords;
+	return res;
+}
+
+void
+WriteJSONString(std::ostream& os, const std::string& str)
+{
+	os << '"';
+	for(const char c : str)
+		switch(c)
+		{
+		case '"':
+			os << "\\\"";
+			break;
+		case '\\':
+			os << "\\\\";
+			break;
+		default:
+			if(static_cast<unsigned char>(c) < 0x20)
+			{
+				char buf[8];
+
+				std::snprintf(buf, sizeof(buf), "\\u%04x", unsigned(c));
+				os << buf;
+			}
+			else
+				os << c;
+		}
+	os << '"';
+}
+
+void
+WriteReport(std::ostream& os, const std::vector<WorkloadResult>& results,
+	size_t warmup, size_t repeat)
+{
+	os << "{\n\t\"warmup\": " << warmup << ",\n\t\"repetitions\": " << repeat
+		<< ",\n\t\"workloads\": [";
+	for(size_t i(0); i != results.size(); ++i)
+	{
+		const auto& r(results[i]);
+		const auto& t(r.Times);
+
+		os << (i == 0 ? "\n" : ",\n") << "\t\t{\n\t\t\t\"name\": ";
+		WriteJSONString(os, r.Name);
+		os << ",\n\t\t\t\"times_ms\": [";
+		for(size_t j(0); j != t.size(); ++j)
+			os << (j == 0 ? "" : ", ") << t[j];
+		os << "],\n\t\t\t\"mean_ms\": " << (t.empty() ? 0.
+			: std::accumulate(t.cbegin(), t.cend(), 0.) / double(t.size()))
+			<< ",\n\t\t\t\"min_ms\": " << (t.empty() ? 0.
+			: *std::min_element(t.cbegin(), t.cend()))
+			<< ",\n\t\t\t\"tail_actions\": " << r.TailActions
+			<< ",\n\t\t\t\"allocations\": " << r.Allocations
+			<< ",\n\t\t\t\"allocated_bytes\": " << r.AllocatedBytes
+			<< ",\n\t\t\t\"resolution_cache_hits\": "
+			<< r.ResolutionCacheHits
+			<< ",\n\t\t\t\"resolution_cache_misses\": "
+			<< r.ResolutionCacheMisses
+			<< ",\n\t\t\t\"compressed_frame_records\": "
+			<< r.CompressedFrameRecords
+			<< ",\n\t\t\t\"max_frame_records\": " << r.MaxFrameRecords
+			<< "\n\t\t}";
+	}
+	os << "\n\t]\n}" << std::endl;
+}
+
+YB_ATTR_nodiscard size_t
+ParseCount(const char* str)
+{
+	char* p_end;
+	const auto n(std::strtoul(str, &p_end, 10));
+
+	if(*str != char() && *p_end == char())
+		return size_t(n);
+	throw std::invalid_argument(std::string("Invalid count '") + str
+		+ "' found.");
+}
+
+} // unnamed namespace;
+
+} // namespace Unilang;
+
+int
+main(int argc, char* argv[])
+{
+	using namespace Unilang;
+
+	return YSLib::FilterExceptions([&]{
+		size_t warmup(1), repeat(5);
+		std::string output;
+		std::vector<std::string> paths;
+
+		for(int i(1); i < argc; ++i)
+		{
+			const string_view arg(argv[i]);
+
+			if((arg == "-w" || arg == "-n" || arg == "-o") && i + 1 < argc)
+			{
+				const auto val(argv[++i]);
+
+				if(arg == "-w")
+					warmup = ParseCount(val);
+				else if(arg == "-n")
+					repeat = ParseCount(val);
+				else
+					output = val;
+			}
+			else
+				paths.emplace_back(arg.data(), arg.size());
+		}
+		if(paths.empty())
+		{
+			std::clog << "Usage: " << argv[0] << " [-w WARMUP] [-n REPEAT]"
+				" [-o OUTPUT] WORKLOAD..." << std::endl;
+			return;
+		}
+
+		std::vector<WorkloadResult> results;
+		// NOTE: The options of the harness are not passed to the interpreter.
+		int intp_argc(1);
+		char* intp_argv[]{argv[0], {}};
+
+		for(const auto& path : paths)
+		{
+			std::clog << "Running workload: " << path << std::endl;
+			results.push_back(RunWorkload(path, warmup, repeat, intp_argc,
+				intp_argv));
+		}
+		if(!output.empty())
+		{
+			std::ofstream ofs(output);
+
+			WriteReport(ofs, results, warmup, repeat);
+		}
+		else
+			WriteReport(std::cout, results, warmup, repeat);
+	}, yfsig, YSLib::Alert) ? EXIT_FAILURE : EXIT_SUCCESS;
+}
+
@@ -9,30 +9,35 @@ YSLib_BaseDir="$Unilang_BaseDir/3rdparty/YSLib"
 
 . "$Unilang_BaseDir/detect-llvm.sh"
 
+# NOTE: The build identifier is used to check the term images, see
+#	src/Image.cpp.
+: "${Unilang_BuildId:=$(git -C "$Unilang_BaseDir" describe --always --dirty \
+	2> /dev/null || echo unknown)}"
+
 CXXFLAGS_Qt="$(pkg-config --cflags Qt5Widgets Qt5Quick)"
 LIBS_Qt="$(pkg-config --libs Qt5Widgets Qt5Quick)"
 
-echo "Building ..."
-
 case $(uname) in
 *MSYS* | *MINGW*)
-	EXTRA_OPT="-I$YSLib_BaseDir/YFramework/Win32/include \
-$YSLib_BaseDir/YFramework/source/YCLib/Host.cpp \
-$YSLib_BaseDir/YFramework/Win32/source/YCLib/MinGW32.cpp \
-$YSLib_BaseDir/YFramework/Win32/source/YCLib/NLS.cpp \
-$YSLib_BaseDir/YFramework/Win32/source/YCLib/Registry.cpp \
-$YSLib_BaseDir/YFramework/Win32/source/YCLib/Consoles.cpp"
+	EXTRA_CXXFLAGS="-I$YSLib_BaseDir/YFramework/Win32/include"
+	EXTRA_LIBS=''
+	EXTRA_SRCS=("$YSLib_BaseDir/YFramework/source/YCLib/Host.cpp" \
+"$YSLib_BaseDir/YFramework/Win32/source/YCLib/MinGW32.cpp" \
+"$YSLib_BaseDir/YFramework/Win32/source/YCLib/NLS.cpp" \
+"$YSLib_BaseDir/YFramework/Win32/source/YCLib/Registry.cpp" \
+"$YSLib_BaseDir/YFramework/Win32/source/YCLib/Consoles.cpp")
 	;;
 *)
-	EXTRA_OPT="-fPIC -pthread \
-$YSLib_BaseDir/YFramework/source/CHRLib/chrmap.cpp -ldl"
+	EXTRA_CXXFLAGS='-fPIC -pthread'
+	EXTRA_LIBS='-ldl'
+	EXTRA_SRCS=("$YSLib_BaseDir/YFramework/source/CHRLib/chrmap.cpp")
 esac
 
-# shellcheck disable=2086
-"$CXX" $CXXFLAGS -ounilang $Unilang_BaseDir/src/*.cpp \
-$CXXFLAGS_EXTRA \
--Iinclude -I$YSLib_BaseDir/YBase/include \
-"$YSLib_BaseDir/YBase/source/ystdex/any.cpp" \
+SRCS=()
+for src in "$Unilang_BaseDir"/src/*.cpp; do
+	[[ "$src" == */Main.cpp ]] || SRCS+=("$src")
+done
+SRCS+=("$YSLib_BaseDir/YBase/source/ystdex/any.cpp" \
 "$YSLib_BaseDir/YBase/source/ystdex/cassert.cpp" \
 "$YSLib_BaseDir/YBase/source/ystdex/concurrency.cpp" \
 "$YSLib_BaseDir/YBase/source/ystdex/cstdio.cpp" \
@@ -40,7 +45,6 @@ $CXXFLAGS_EXTRA \
 "$YSLib_BaseDir/YBase/source/ystdex/memory_resource.cpp" \
 "$YSLib_BaseDir/YBase/source/ystdex/node_base.cpp" \
 "$YSLib_BaseDir/YBase/source/ystdex/tree.cpp" \
--I$YSLib_BaseDir/YFramework/include \
 "$YSLib_BaseDir/YFramework/source/CHRLib/CharacterProcessing.cpp" \
 "$YSLib_BaseDir/YFramework/source/CHRLib/MappingEx.cpp" \
 "$YSLib_BaseDir/YFramework/source/YCLib/Debug.cpp" \
@@ -54,7 +58,49 @@ $CXXFLAGS_EXTRA \
 "$YSLib_BaseDir/YFramework/source/YSLib/Core/YObject.cpp" \
 "$YSLib_BaseDir/YFramework/source/YSLib/Service/File.cpp" \
 "$YSLib_BaseDir/YFramework/source/YSLib/Service/TextFile.cpp" \
-$CXXFLAGS_Qt $LIBS_Qt $EXTRA_OPT $LIBS_EXTRA
+"${EXTRA_SRCS[@]}")
+
+compile_object()
+{
+	local obj="$1"
+
+	shift
+	# shellcheck disable=2086
+	"$CXX" $CXXFLAGS -c -o"$obj" "$@" \
+$CXXFLAGS_EXTRA "-DUnilang_BuildId=\"$Unilang_BuildId\"" \
+-Iinclude -I"$YSLib_BaseDir/YBase/include" \
+-I"$YSLib_BaseDir/YFramework/include" $CXXFLAGS_Qt $EXTRA_CXXFLAGS
+}
+
+link_target()
+{
+	local target="$1"
+
+	shift
+	# shellcheck disable=2086
+	"$CXX" $CXXFLAGS -o"$target" "$@" $EXTRA_CXXFLAGS $LIBS_Qt $EXTRA_LIBS \
+$LIBS_EXTRA
+}
+
+# NOTE: The objects are shared by the targets, so the sources are compiled once
+#	except src/Main.cpp, which is compiled again without %main for the
+#	benchmark harness.
+OBJ_DIR="$(mktemp -d)"
+trap 'rm -rf "$OBJ_DIR"' EXIT
+OBJS=()
+echo "Building ..."
+for i in "${!SRCS[@]}"; do
+	compile_object "$OBJ_DIR/$i.o" "${SRCS[$i]}"
+	OBJS+=("$OBJ_DIR/$i.o")
+done
+compile_object "$OBJ_DIR/Main.o" "$Unilang_BaseDir/src/Main.cpp"
+link_target unilang "${OBJS[@]}" "$OBJ_DIR/Main.o"
+echo "Building the benchmark harness ..."
+compile_object "$OBJ_DIR/Main-NoMain.o" -DUnilang_NoMain \
+"$Unilang_BaseDir/src/Main.cpp"
+compile_object "$OBJ_DIR/Harness.o" "$Unilang_BaseDir/bench/Harness.cpp"
+link_target unilang-bench "${OBJS[@]}" "$OBJ_DIR/Main-NoMain.o" \
+"$OBJ_DIR/Harness.o"
 
 echo "Done."
 
@@ -6,7 +6,7 @@
 #include "TermAccess.h" // for ValueObject, vector, string, pair, lref,
 //	TermNode, ystdex::less, map, AnchorPtr, pmr, yforward, Unilang::Deref,
 //	string_view, type_info, Unilang::allocate_shared, observer_ptr,
-//	EnvironmentReference, stack;
+//	EnvironmentReference, stack, SymbolAtom;
 #include <ystdex/operators.hpp> // for ystdex::equality_comparable;
 #include <ystdex/container.hpp> // for ystdex::try_emplace,
 //	ystdex::try_emplace_hint, ystdex::insert_or_assign;
@@ -15,15 +15,20 @@
 #include YFM_YSLib_Core_YEvent // for ystdex::GHEvent;
 #include <cassert> // for assert;
 #include <ystdex/memory.hpp> // for ystdex::make_obj_using_allocator;
+#include <ystdex/memory_resource.h> // for
+//	ystdex::pmr::unsynchronized_pool_resource;
 #include <ystdex/swap.hpp> // for ystdex::swap_depedent;
 #include <ystdex/functor.hpp> // for ystdex::ref_eq;
 #include <exception> // for std::exception_ptr;
-#include "Parser.h" // for ParseResultOf, ByteParser, SourcedByteParser;
+#include "Parser.h" // for ParseResultOf, ByteParser, SourcedByteParser,
+//	ViewParser, SourcedViewParser, UnescapeLexeme, MakeLexemeToken;
 #include "Lexical.h" // for LexicalAnalyzer;
 #include <ystdex/ref.hpp> // for ystdex::ref, ystdex::unref;
 #include <algorithm> // for std::for_each;
 #include <streambuf> // for std::streambuf;
 #include <istream> // for std::istream;
+#include <iterator> // for std::istreambuf_iterator;
+#include <new> // for placement ::operator new;
 
 namespace Unilang
 {
@@ -37,6 +42,42 @@ namespace Unilang
 #endif
 
 
+// NOTE: The phases of the interpreter for the accounting of the allocations,
+//	see %TrackingResource in Interpreter.h.
+enum class AllocationPhase : size_t
+{
+	Other,
+	Parse,
+	Preprocess,
+	Reduction,
+	Environment
+};
+
+constexpr const size_t AllocationPhaseCount(5);
+
+// NOTE: The current phase is kept per thread.
+YB_ATTR_nodiscard AllocationPhase&
+FetchAllocationPhaseRef() noexcept;
+
+class AllocationPhaseGuard final
+{
+private:
+	AllocationPhase saved;
+
+public:
+	AllocationPhaseGuard(AllocationPhase phase) noexcept
+		: saved(FetchAllocationPhaseRef())
+	{
+		FetchAllocationPhaseRef() = phase;
+	}
+	AllocationPhaseGuard(const AllocationPhaseGuard&) = delete;
+	~AllocationPhaseGuard()
+	{
+		FetchAllocationPhaseRef() = saved;
+	}
+};
+
+
 using EnvironmentList = vector<ValueObject>;
 
 
@@ -47,13 +88,49 @@ public:
 	using NameResolution
 		= pair<BindingMap::mapped_type*, shared_ptr<Environment>>;
 	using allocator_type = BindingMap::allocator_type;
+	using AtomIndex = vector<pair<SymbolAtom, BindingMap::mapped_type*>>;
+	// NOTE: The maximum number of bindings in the frame.
+	static constexpr size_t FrameCapacity = 4;
 
+private:
+	// NOTE: The binding stored in the frame.
+	struct FrameSlot final
+	{
+		string Name;
+		TermNode Term;
+
+		template<typename... _tParams>
+		inline
+		FrameSlot(string_view id, allocator_type a, _tParams&&... args)
+			: Name(id.data(), id.size(), a), Term(yforward(args)...)
+		{}
+	};
+
+	// NOTE: The bindings not in the frame. They are not exposed, as the names
+	//	shall not be bound in both the frame and the map.
 	mutable BindingMap Bindings;
+
+public:
 	ValueObject Parent{};
 	bool Frozen = {};
 
 private:
+	// NOTE: The frame holds the first few bindings of an environment in a
+	//	single block allocated on the first binding, which is typical for call
+	//	frames. This replaces the allocation and the rebalancing of one map
+	//	node per binding, while the environments without bindings only pay for
+	//	the pointer. Bindings are only added to the frame when %Bindings is
+	//	empty, so further bindings spill to %Bindings. Bound objects in the
+	//	frame are not relocated during the lifetime of the environment, except
+	//	by the move assignment (see below).
+	FrameSlot* p_frame = {};
+	size_t frame_size = 0;
 	AnchorPtr p_anchor{InitAnchor()};
+	// NOTE: The bindings indexed by the atoms of the names, sorted by the atoms.
+	//	It is only used for environments having enough bindings, and it is
+	//	rebuilt lazily once the size differs to %Bindings. So the bindings
+	//	shall not be removed from %Bindings directly.
+	mutable AtomIndex atom_index{Bindings.get_allocator()};
 
 public:
 	Environment(allocator_type a)
@@ -82,13 +159,17 @@ public:
 	Environment(pmr::memory_resource& rsrc, ValueObject&& vo)
 		: Environment(std::move(vo), allocator_type(&rsrc))
 	{}
-	Environment(const Environment& e)
-		: Bindings(e.Bindings), Parent(e.Parent)
-	{}
-	Environment(Environment&&) = default;
-
+	Environment(const Environment&);
+	// NOTE: The frame is transferred to the destination, so the references to
+	//	the bound objects are kept valid.
+	Environment(Environment&&);
+	~Environment();
+
+	// NOTE: The frame is transferred if the allocators are equal. Otherwise,
+	//	the bound objects in the frame are relocated, and the references to
+	//	them are invalidated.
 	Environment&
-	operator=(Environment&&) = default;
+	operator=(Environment&&);
 
 	YB_ATTR_nodiscard YB_PURE friend bool
 	operator==(const Environment& x, const Environment& y) noexcept
@@ -115,28 +196,90 @@ public:
 		return p_anchor;
 	}
 
+	YB_ATTR_nodiscard YB_PURE allocator_type
+	get_allocator() const noexcept
+	{
+		return Bindings.get_allocator();
+	}
+
 	template<typename _tKey, typename... _tParams>
 	inline ystdex::enable_if_inconvertible_t<_tKey&&,
 		BindingMap::const_iterator, bool>
 	AddValue(_tKey&& k, _tParams&&... args)
 	{
-		return ystdex::try_emplace(Bindings, yforward(k), NoContainer,
-			yforward(args)...).second;
+		const string_view id(k);
+
+		// NOTE: The frame shall be checked even if %Bindings is not empty, as
+		//	the names in the frame are not in %Bindings.
+		if(frame_size != 0 && FindFrameSlot(id))
+			return {};
+		if(Bindings.empty() && frame_size < FrameCapacity)
+		{
+			EmplaceFrameSlot(id, std::allocator_arg, Bindings.get_allocator(),
+				NoContainer, yforward(args)...);
+			NotifyModified();
+			return true;
+		}
+
+		const auto pr(ystdex::try_emplace(Bindings, yforward(k), NoContainer,
+			yforward(args)...));
+
+		if(pr.second)
+		{
+			IndexBinding(*pr.first);
+			NotifyModified();
+		}
+		return pr.second;
 	}
 	template<typename _tKey, typename... _tParams>
 	inline bool
 	AddValue(BindingMap::const_iterator hint, _tKey&& k, _tParams&&... args)
 	{
-		return ystdex::try_emplace_hint(Bindings, hint, yforward(k),
-			NoContainer, yforward(args)...).second;
+		if(frame_size != 0 && FindFrameSlot(k))
+			return {};
+
+		const auto pr(ystdex::try_emplace_hint(Bindings, hint, yforward(k),
+			NoContainer, yforward(args)...));
+
+		if(pr.second)
+		{
+			IndexBinding(*pr.first);
+			NotifyModified();
+		}
+		return pr.second;
 	}
 
 	template<typename _tKey, class _tNode>
 	TermNode&
 	Bind(_tKey&& k, _tNode&& tm)
 	{
-		return Unilang::Deref(ystdex::insert_or_assign(Bindings, yforward(k),
-			yforward(tm)).first).second;
+		const string_view id(k);
+
+		if(frame_size != 0)
+			if(const auto p = FindFrameSlot(id))
+				return *p = yforward(tm);
+		if(Bindings.empty() && frame_size < FrameCapacity)
+		{
+			auto& nd(EmplaceFrameSlot(id, yforward(tm),
+				Bindings.get_allocator()));
+
+			NotifyModified();
+			return nd;
+		}
+
+		const auto res(ystdex::insert_or_assign(Bindings, yforward(k),
+			yforward(tm)));
+		auto& pr(Unilang::Deref(res.first));
+
+		// NOTE: Only the inserted binding is indexed. Otherwise, an existing
+		//	name would be indexed twice, and the index would be considered
+		//	synchronized with some bindings missing.
+		if(res.second)
+		{
+			IndexBinding(pr);
+			NotifyModified();
+		}
+		return pr.second;
 	}
 
 	static void
@@ -148,13 +291,60 @@ public:
 	static Environment&
 	EnsureValid(const shared_ptr<Environment>&);
 
+	// NOTE: This increases the version kept in the anchor, which invalidates
+	//	the cached resolutions walking through the environment. It shall be
+	//	called after %Parent is changed. It is also called when a binding is
+	//	added or the anchor is moved or released.
+	void
+	NotifyModified() const noexcept;
+
 private:
+	YB_ATTR_nodiscard FrameSlot&
+	AccessFrameSlot(size_t i) const noexcept
+	{
+		assert(i < frame_size && "Invalid slot index found.");
+		return p_frame[i];
+	}
+
+	void
+	AllocateFrame();
+
+	void
+	ClearFrame() noexcept;
+
+	template<typename... _tParams>
+	TermNode&
+	EmplaceFrameSlot(string_view id, _tParams&&... args)
+	{
+		assert(frame_size < FrameCapacity && "Frame overflow found.");
+		if(!p_frame)
+			AllocateFrame();
+
+		const auto p(::new(p_frame + frame_size)
+			FrameSlot(id, Bindings.get_allocator(), yforward(args)...));
+
+		++frame_size;
+		return p->Term;
+	}
+
+	void
+	ReleaseFrame() noexcept;
+
+	YB_ATTR_nodiscard YB_PURE TermNode*
+	FindFrameSlot(string_view) const noexcept;
+
+	void
+	IndexBinding(BindingMap::value_type&) const;
+
 	YB_ATTR_nodiscard YB_PURE AnchorPtr
 	InitAnchor() const;
 
 public:
 	YB_ATTR_nodiscard YB_PURE NameResolution::first_type
 	LookupName(string_view) const;
+	// NOTE: The atom shall be the interned value of the name.
+	YB_ATTR_nodiscard YB_PURE NameResolution::first_type
+	LookupName(SymbolAtom, string_view) const;
 
 	YB_ATTR_nodiscard YB_PURE TermTags
 	MakeTermTags(const TermNode& term) const noexcept
@@ -246,6 +436,9 @@ public:
 
 class GlobalState;
 
+// NOTE: See Evaluation.h for the definition.
+class CombinerProfile;
+
 class Context final
 {
 private:
@@ -330,15 +523,22 @@ public:
 
 private:
 	lref<pmr::memory_resource> memory_rsrc;
+	// NOTE: The nodes of the reducer sequences and the targets of the reducers
+	//	not fit in the small buffer are allocated in nearly LIFO order, so they
+	//	are pooled here without the synchronization or the upstream calls.
+	mutable pmr::unsynchronized_pool_resource
+		reducer_rsrc{&memory_rsrc.get()};
 	shared_ptr<Environment> p_record{Unilang::allocate_shared<Environment>(
 		Environment::allocator_type(&memory_rsrc.get()))};
-	ReducerSequence
-		current{ReducerSequence::allocator_type(&memory_rsrc.get())};
+	ReducerSequence current{ReducerSequence::allocator_type(&reducer_rsrc)};
 	ReducerSequence stacked{current.get_allocator()};
 
 public:
 	Reducer TailAction{};
 	ExceptionHandler HandleException{DefaultHandleException};
+	// NOTE: If not empty, this is called before each tail action is applied,
+	//	e.g. to sample the current actions.
+	function<void(const Context&)> TraceTail{};
 	ReductionStatus LastStatus = ReductionStatus::Neutral;
 	lref<const GlobalState> Global;
 
@@ -346,10 +546,42 @@ private:
 	TermNode* next_term_ptr = {};
 	TermNode* combining_term_ptr = {};
 
+	// NOTE: The maximum number of the environments walked by a cached
+	//	resolution.
+	static constexpr size_t ResolutionPathCapacity = 4;
+	struct ResolutionCacheEntry final
+	{
+		// NOTE: The anchor of the parent of the starting environment. It is
+		//	only kept to prevent the storage being reused by another anchor.
+		weak_ptr<const void> KeyAnchor{};
+		SymbolAtom Atom = 0;
+		size_t PathSize = 0;
+		// NOTE: The anchors and the versions of the walked environments, from
+		//	the parent of the starting environment to the target.
+		array<pair<const void*, size_t>, ResolutionPathCapacity> Path{};
+		Environment::NameResolution::first_type Bound = {};
+		weak_ptr<Environment> Target{};
+	};
+	// NOTE: The direct-mapped cache of successful resolutions which are not
+	//	found in the starting environment, keyed by the anchor of the parent
+	//	of the starting environment and the atom of the name. It is allocated
+	//	on the first use.
+	mutable vector<ResolutionCacheEntry> resolution_cache{};
+
 public:
+	// NOTE: The statistics of the resolution cache, see %Resolve.
+	mutable size_t ResolutionCacheHits = 0;
+	mutable size_t ResolutionCacheMisses = 0;
 	Continuation ReduceOnce{DefaultReduceOnce, *this};
 	mutable ValueObject OperatorName{};
 	shared_ptr<string> CurrentSource{};
+	// NOTE: If not null, the calls to the combiners are counted in the
+	//	profile.
+	shared_ptr<CombinerProfile> CombinerProfilePtr{};
+	// NOTE: The statistics of the frame records of the TCO actions, see
+	//	%TCOAction::CompressFrameList in TCO.h.
+	size_t CompressedFrameRecords = 0;
+	size_t MaxFrameRecords = 0;
 
 	Context(const GlobalState&);
 
@@ -359,11 +591,6 @@ public:
 		return !current.empty();
 	}
 
-	YB_ATTR_nodiscard Environment::BindingMap&
-	GetBindingsRef() const noexcept
-	{
-		return p_record->Bindings;
-	}
 	TermNode*
 	GetCombiningTermPtr() const noexcept
 	{
@@ -381,6 +608,13 @@ public:
 	}
 	YB_ATTR_nodiscard YB_PURE TermNode&
 	GetNextTermRef() const;
+	// NOTE: This is the allocator of all reducer sequences which can be
+	//	spliced with the current sequence.
+	YB_ATTR_nodiscard YB_PURE ContextAllocator
+	GetReducerAllocator() const noexcept
+	{
+		return ContextAllocator(&reducer_rsrc);
+	}
 	YB_ATTR_nodiscard YB_PURE const shared_ptr<Environment>&
 	GetRecordPtr() const noexcept
 	{
@@ -440,6 +674,11 @@ public:
 
 	YB_ATTR_nodiscard Environment::NameResolution
 	Resolve(shared_ptr<Environment>, string_view) const;
+	// NOTE: The atom shall be the interned value of the name. The result is
+	//	cached by the parent of the environment and the atom, and it is reused
+	//	only when the versions of the walked environments are not changed.
+	YB_ATTR_nodiscard Environment::NameResolution
+	Resolve(shared_ptr<Environment>, SymbolAtom, string_view) const;
 
 	void
 	SaveExceptionHandler()
@@ -463,7 +702,7 @@ public:
 	SetupFront(_tParams&&... args)
 	{
 		current.push_front(
-			Unilang::ToReducer(get_allocator(), yforward(args)...));
+			Unilang::ToReducer(GetReducerAllocator(), yforward(args)...));
 	}
 
 	template<typename... _tParams>
@@ -562,20 +801,22 @@ template<typename... _tParams>
 inline shared_ptr<Environment>
 AllocateEnvironment(const Environment::allocator_type& a, _tParams&&... args)
 {
+	const AllocationPhaseGuard gd(AllocationPhase::Environment);
+
 	return Unilang::allocate_shared<Environment>(a, yforward(args)...);
 }
 template<typename... _tParams>
 inline shared_ptr<Environment>
 AllocateEnvironment(Context& ctx, _tParams&&... args)
 {
-	return Unilang::AllocateEnvironment(ctx.GetBindingsRef().get_allocator(),
+	return Unilang::AllocateEnvironment(ctx.GetRecordRef().get_allocator(),
 		yforward(args)...);
 }
 template<typename... _tParams>
 inline shared_ptr<Environment>
 AllocateEnvironment(TermNode& term, Context& ctx, _tParams&&... args)
 {
-	const auto a(ctx.GetBindingsRef().get_allocator());
+	const auto a(ctx.GetRecordRef().get_allocator());
 
 	static_cast<void>(term);
 	Unilang::AssertMatchedAllocators(a, term);
@@ -615,7 +856,15 @@ template<typename _type, typename... _tParams>
 inline bool
 EmplaceLeaf(Environment& env, string_view name, _tParams&&... args)
 {
-	return Unilang::EmplaceLeaf<_type>(env.Bindings, name, yforward(args)...);
+	assert(name.data());
+	if(const auto p = env.LookupName(name))
+	{
+		p->Value = _type(yforward(args)...);
+		p->ClearContainer();
+		return {};
+	}
+	return env.AddValue(name,
+		ValueObject(in_place_type<_type>, yforward(args)...));
 }
 template<typename _type, typename... _tParams>
 inline bool
@@ -684,9 +933,13 @@ private:
 	using TermStackEntry = pair<lref<TermNode>, bool>;
 	using TermStack = stack<TermStackEntry, vector<TermStackEntry>>;
 	struct TransformationSpec;
+	// NOTE: Each bit indicates a transformation in the same position.
+	using SpecMask = unsigned;
 
 	TermNode::allocator_type allocator;
 	vector<TransformationSpec> transformations;
+	// NOTE: This is indexed by the atoms of the delimiters.
+	vector<SpecMask> atom_masks{allocator};
 	mutable TermStack remained{allocator};
 
 public:
@@ -698,6 +951,22 @@ public:
 
 	void
 	Transform(TermNode&, bool, TermStack&) const;
+
+	// NOTE: The index of the transformation whose prefix is equal to the
+	//	value, or %size_t(-1) if not found.
+	YB_ATTR_nodiscard YB_PURE size_t
+	FindPrefix(const ValueObject&) const;
+
+	// NOTE: The prefix is empty if the delimiter is used as the prefix.
+	YB_ATTR_nodiscard YB_PURE const ValueObject&
+	GetPrefix(size_t) const;
+
+private:
+	YB_ATTR_nodiscard SpecMask
+	Classify(const TermNode&) const;
+
+	YB_ATTR_nodiscard SpecMask
+	ClassifyChildren(const TermNode&) const;
 };
 
 
@@ -708,13 +977,31 @@ template<typename _fParse, typename... _tParams>
 using GTokenizer
 	= function<TermNode(const GParsedValue<_fParse>&, _tParams...)>;
 
-using Tokenizer = GTokenizer<ByteParser>;
+// NOTE: The tokenizers take the lexemes in the results of the view parsers.
+//	This is an API change: the tokenizers used to take the results of the
+//	byte parsers, whose types are kept as %ByteTokenizer and
+//	%SourcedByteTokenizer. Such tokenizers can still be installed after
+//	adapted by %AdaptTokenizer and %AdaptSourcedTokenizer, which copy the
+//	lexemes.
+using Tokenizer = GTokenizer<ViewParser>;
+
+using SourcedTokenizer = GTokenizer<SourcedViewParser, Context&>;
 
-using SourcedTokenizer = GTokenizer<SourcedByteParser, Context&>;
+using ByteTokenizer = GTokenizer<ByteParser>;
+
+using SourcedByteTokenizer = GTokenizer<SourcedByteParser, Context&>;
+
+YB_ATTR_nodiscard Tokenizer
+AdaptTokenizer(ByteTokenizer);
+
+YB_ATTR_nodiscard SourcedTokenizer
+AdaptSourcedTokenizer(SourcedByteTokenizer);
 
 
 class GlobalState
 {
+	friend class FormReader;
+
 private:
 	struct LeafConverter final
 	{
@@ -723,12 +1010,39 @@ private:
 		YB_ATTR_nodiscard TermNode
 		operator()(const GParsedValue<ByteParser>& val) const
 		{
-			return ContextRef.Global.get().ConvertLeaf(val);
+			return ContextRef.Global.get().ConvertLeaf(
+				MakeLexemeToken(YSLib::make_string_view(val)));
 		}
 		YB_ATTR_nodiscard TermNode
 		operator()(const GParsedValue<SourcedByteParser>& val) const
 		{
-			return ContextRef.Global.get().ConvertLeafSourced(val, ContextRef);
+			return ContextRef.Global.get().ConvertLeafSourced({val.first,
+				MakeLexemeToken(YSLib::make_string_view(val.second))},
+				ContextRef);
+		}
+		// NOTE: The lexemes with escape sequences are materialized and
+		//	classified again before the conversion. Others are converted in
+		//	place.
+		YB_ATTR_nodiscard TermNode
+		operator()(const GParsedValue<ViewParser>& val) const
+		{
+			auto& global(ContextRef.Global.get());
+
+			if(val.Lexeme.find('\\') == string_view::npos)
+				return global.ConvertLeaf(val);
+			return global.ConvertLeaf(MakeLexemeToken(YSLib::make_string_view(
+				UnescapeLexeme(val.Lexeme, global.Allocator))));
+		}
+		YB_ATTR_nodiscard TermNode
+		operator()(const GParsedValue<SourcedViewParser>& val) const
+		{
+			auto& global(ContextRef.Global.get());
+
+			if(val.second.Lexeme.find('\\') == string_view::npos)
+				return global.ConvertLeafSourced(val, ContextRef);
+			return global.ConvertLeafSourced({val.first,
+				MakeLexemeToken(YSLib::make_string_view(UnescapeLexeme(
+				val.second.Lexeme, global.Allocator)))}, ContextRef);
 		}
 	};
 
@@ -754,9 +1068,14 @@ public:
 	Prepare(Context& ctx, _tIn first, _tIn last, _fParse parse) const
 	{
 		std::for_each(first, last, parse);
+		return PrepareLexemes(ctx, ystdex::unref(parse).GetResult());
+	}
 
+	template<class _tParseResult>
+	YB_ATTR_nodiscard TermNode
+	PrepareLexemes(Context& ctx, const _tParseResult& parse_result) const
+	{
 		TermNode res{Allocator};
-		const auto& parse_result(ystdex::unref(parse).GetResult());
 
 		if(ReduceSyntax(res, parse_result.cbegin(), parse_result.cend(),
 			LeafConverter{ctx}) != parse_result.cend())
@@ -767,12 +1086,58 @@ public:
 	YB_ATTR_nodiscard TermNode
 	Read(string_view, Context&);
 
+private:
+	// NOTE: The source is scanned in place by the view parsers if possible.
+	YB_ATTR_nodiscard TermNode
+	ReadInPlace(string_view, Context&) const;
+
+public:
 	YB_ATTR_nodiscard TermNode
 	ReadFrom(std::streambuf&, Context&) const;
 	YB_ATTR_nodiscard TermNode
 	ReadFrom(std::istream&, Context&) const;
 };
 
+
+// NOTE: This reads the top-level forms separated by ';' from the stream
+//	buffer one by one, so each form can be evaluated before the rest of the
+//	source is read. The lexemes of a form are released once the form is read.
+//	A single term in a form is not wrapped, as %SeparatorPass does for the
+//	whole source. If there is no separator, the whole source is read as a
+//	single form, the same to %GlobalState::ReadFrom.
+class FormReader final
+{
+private:
+	lref<const GlobalState> global_ref;
+	lref<Context> context_ref;
+	shared_ptr<string> source;
+	std::istreambuf_iterator<char> current;
+	LexicalAnalyzer lexer{};
+	ByteParser parse;
+	SourcedByteParser parse_sourced;
+	size_t scanned = 0;
+	size_t depth = 0;
+	bool separated = {};
+	bool finished = {};
+
+public:
+	FormReader(const GlobalState&, std::streambuf&, Context&);
+	FormReader(const FormReader&) = delete;
+
+	// NOTE: This returns false if there are no more forms.
+	YB_ATTR_nodiscard bool
+	Read(TermNode&);
+
+private:
+	template<class _tParser>
+	YB_ATTR_nodiscard bool
+	ReadWith(TermNode&, _tParser&);
+
+	template<class _tParser>
+	YB_ATTR_nodiscard bool
+	TakeForm(TermNode&, _tParser&, size_t);
+};
+
 } // namespace Unilang;
 
 #endif
@@ -4,8 +4,8 @@
 #define INC_Unilang_Evaluation_h_ 1
 
 #include "TermNode.h" // for TermNode, ValueObject, string_view, shared_ptr,
-//	type_id, YSLib::Logger;
-#include "Parser.h" // for SourceLocation;
+//	type_id, YSLib::Logger, lref;
+#include "Parser.h" // for SourceLocation, LexemeCategory;
 #include "Context.h" // for ReductionStatus, Context, YSLib::AreEqualHeld,
 //	YSLib::GHEvent, allocator_arg, ContextHandler, std::allocator_arg_t,
 //	Unilang::SwitchToFreshEnvironment, HasValue;
@@ -31,6 +31,8 @@
 #include <ystdex/scope_guard.hpp> // for ystdex::guard;
 #include <ystdex/meta.hpp> // for ystdex::remove_cvref_t;
 #include <ystdex/functional.hpp> // for ystdex::expanded_caller;
+#include <chrono> // for std::chrono::steady_clock;
+#include <ostream> // for std::ostream;
 
 namespace Unilang
 {
@@ -58,6 +60,56 @@ ReductionStatus
 ReduceOrdered(TermNode&, Context&);
 
 
+// NOTE: The value of a leaf standing for an unexpanded subterm shared with the
+//	evaluation structure of a combiner, which is expanded on demand by
+//	%ReduceOnce. The other operations shall not access such terms before
+//	%MaterializeSharedCode is called.
+class SharedCode final : private ystdex::equality_comparable<SharedCode>
+{
+private:
+	shared_ptr<const TermNode> p_root;
+	lref<const TermNode> node_ref;
+
+public:
+	SharedCode(shared_ptr<const TermNode> p, const TermNode& nd) noexcept
+		: p_root(std::move(p)), node_ref(nd)
+	{
+		assert(p_root && "Invalid root found.");
+	}
+
+	YB_ATTR_nodiscard YB_PURE friend bool
+	operator==(const SharedCode& x, const SharedCode& y) noexcept
+	{
+		return &x.node_ref.get() == &y.node_ref.get();
+	}
+
+	YB_ATTR_nodiscard YB_PURE const shared_ptr<const TermNode>&
+	GetRootPtr() const noexcept
+	{
+		return p_root;
+	}
+
+	YB_ATTR_nodiscard YB_PURE const TermNode&
+	get() const noexcept
+	{
+		return node_ref.get();
+	}
+};
+
+// NOTE: Set the content of the term to the shared evaluation structure. Only
+//	the top level is copied. The branches are shared as %SharedCode.
+void
+SetSharedContent(TermNode&, const shared_ptr<const TermNode>&);
+
+// NOTE: Expand the term one level if it is a %SharedCode leaf.
+void
+ExpandSharedCode(TermNode&);
+
+// NOTE: Copy all %SharedCode leaves in the subterms of the term.
+void
+MaterializeSharedCode(TermNode&);
+
+
 struct SeparatorTransformer
 {
 	template<typename _func, class _tTerm, class _fPred>
@@ -113,10 +165,24 @@ struct SeparatorTransformer
 
 void
 ParseLeaf(TermNode&, string_view);
+// NOTE: The category is known by the parser, see %CategorizeBasicLexeme.
+void
+ParseLeaf(TermNode&, string_view, LexemeCategory);
 
 void
 ParseLeafWithSourceInformation(TermNode&, string_view,
 	const shared_ptr<string>&, const SourceLocation&);
+void
+ParseLeafWithSourceInformation(TermNode&, string_view,
+	const shared_ptr<string>&, const SourceLocation&, LexemeCategory);
+
+// NOTE: The values are set as the leaves parsed with the source information.
+void
+SetSourcedToken(TermNode&, string_view, const shared_ptr<string>&,
+	const SourceLocation&);
+void
+SetSourcedString(TermNode&, string_view, const shared_ptr<string>&,
+	const SourceLocation&);
 
 
 template<typename _func>
@@ -599,6 +665,29 @@ void
 TraceBacktrace(const Context::ReducerSequence&, YSLib::Logger&) noexcept;
 
 
+// NOTE: The statistics of the calls to the combiners, keyed by the operator
+//	names with the source locations. The time of a call is inclusive.
+class CombinerProfile final
+{
+public:
+	struct Entry final
+	{
+		size_t Calls = 0;
+		std::chrono::steady_clock::duration Time{};
+	};
+
+	map<string, Entry> Entries{};
+
+	void
+	PrintReport(std::ostream&) const;
+
+	// NOTE: The entries are kept since they can be referenced by the pending
+	//	calls.
+	void
+	Reset() noexcept;
+};
+
+
 template<class _tGuard>
 inline ReductionStatus
 KeepGuard(_tGuard&, Context& ctx) noexcept
@@ -440,6 +440,21 @@ EqValue(TermNode&);
 ReductionStatus
 If(TermNode&, Context&);
 
+ReductionStatus
+Cond(TermNode&, Context&);
+
+ReductionStatus
+When(TermNode&, Context&);
+
+ReductionStatus
+Unless(TermNode&, Context&);
+
+ReductionStatus
+And(TermNode&, Context&);
+
+ReductionStatus
+Or(TermNode&, Context&);
+
 
 ReductionStatus
 Cons(TermNode&);
@@ -0,0 +1,84 @@
+﻿// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co.,Ltd.
+
+#ifndef INC_Unilang_Image_h_
+#define INC_Unilang_Image_h_ 1
+
+#include "Context.h" // for string, string_view, TermNode, GlobalState, map;
+
+namespace Unilang
+{
+
+// NOTE: The term image is the binary form of a term which has been read and
+//	preprocessed. Only the values made by the parsers and the prefixes of
+//	%SeparatorPass are supported, and the latter are stored by their indices
+//	in the global state. The image is only valid for the same build of the
+//	interpreter.
+
+// NOTE: The image is appended to the buffer. The result is false if the term
+//	has some unsupported values, and the buffer is unspecified in this case.
+YB_ATTR_nodiscard bool
+WriteTermImage(string&, const TermNode&, const GlobalState&);
+
+// NOTE: The image is consumed from the front of the view. The result is false
+//	if the image is invalid, and the term is unspecified in this case.
+YB_ATTR_nodiscard bool
+ReadTermImage(string_view&, TermNode&, const GlobalState&);
+
+
+// NOTE: The term images keyed by strings, which are saved in a single file. The
+//	file made by a different build of the interpreter is ignored.
+class TermImageFile final
+{
+public:
+	map<string, string> Records{};
+
+	// NOTE: The records are cleared if the file is not a valid image file.
+	bool
+	Load(const string&);
+
+	// NOTE: The file is replaced as a whole, so concurrent readers see either
+	//	the old file or the new one.
+	bool
+	Save(const string&) const;
+};
+
+
+// NOTE: The key of the image of a source file. It depends on the status of the
+//	file, and the result is empty if the status is not available.
+YB_ATTR_nodiscard string
+MakeFileImageKey(const string&, bool);
+
+
+// NOTE: The cache of the preprocessed source files in a directory. The cache
+//	files are named by the hash of the paths of the source files. The records
+//	in a cache file are keyed by the paths, so the source files with the same
+//	hash share the cache file. The keys made by %MakeFileImageKey are also
+//	stored in the records to check the changes of the source files.
+class FileImageCache final
+{
+private:
+	string directory;
+
+public:
+	explicit
+	FileImageCache(string);
+
+	// NOTE: The parameters are the path of the source file and the key made by
+	//	%MakeFileImageKey. The result is false if the cache is not valid.
+	bool
+	Restore(const string&, const string&, TermNode&, const GlobalState&) const;
+
+	// NOTE: The cache file is not updated if the term is not supported.
+	void
+	Record(const string&, const string&, const TermNode&, const GlobalState&)
+		const;
+
+private:
+	YB_ATTR_nodiscard string
+	GetCacheFileName(const string&) const;
+};
+
+} // namespace Unilang;
+
+#endif
+
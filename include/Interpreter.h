@@ -5,36 +5,172 @@
 
 #include "Context.h" // for pair, lref, stack, vector, GlobalState, string,
 //	shared_ptr, Environment, Context, TermNode,
-//	YSLib::Logger, YSLib::unique_ptr, std::istream;
-#include <cstdlib> // for std::getenv;
+//	YSLib::Logger, YSLib::unique_ptr, std::istream, string_view, pmr,
+//	Unilang::Deref;
+#include <cstdlib> // for std::getenv, std::strtoul;
 #include <ostream> // for std::ostream;
+#include <cassert> // for assert;
 
 namespace Unilang
 {
 
+// NOTE: The kinds of the memory resource used by the interpreter.
+enum class MemoryResourceKind
+{
+	// NOTE: The default resource, i.e. %pmr::get_default_resource().
+	Default,
+	// NOTE: The unsynchronized pool over the new-delete resource.
+	Pool,
+	// NOTE: The synchronized pool over the new-delete resource.
+	SynchronizedPool,
+	// NOTE: The monotonic buffer over the new-delete resource. Nothing is
+	//	released before the interpreter is destroyed.
+	Monotonic,
+	// NOTE: The %TrackingResource over the new-delete resource.
+	Tracking
+};
+
+// NOTE: The accepted names are "default", "pool", "sync-pool", "monotonic" and
+//	"tracking". The empty string is same to "default".
+YB_ATTR_nodiscard YB_PURE MemoryResourceKind
+ParseMemoryResourceKind(string_view);
+
+
+// NOTE: The resource counting the allocations and the bytes. It is not
+//	synchronized. Each block from the upstream is prefixed by the phase of the
+//	allocation, so the deallocation is counted in the phase of the allocation
+//	rather than the current phase.
+class TrackingResource final : public pmr::memory_resource
+{
+public:
+	// NOTE: The statistics of the blocks allocated in a phase of the current
+	//	thread, see %AllocationPhase. %PeakBytes is the peak of %CurrentBytes
+	//	of the whole resource observed by the allocations in the phase, not the
+	//	peak of the bytes allocated in the phase only.
+	struct PhaseStatistics final
+	{
+		size_t AllocationCount = 0;
+		size_t DeallocationCount = 0;
+		size_t AllocatedBytes = 0;
+		size_t DeallocatedBytes = 0;
+		size_t PeakBytes = 0;
+	};
+
+private:
+	lref<pmr::memory_resource> upstream;
+
+public:
+	size_t AllocationCount = 0;
+	size_t DeallocationCount = 0;
+	size_t AllocatedBytes = 0;
+	size_t CurrentBytes = 0;
+	size_t PeakBytes = 0;
+	array<PhaseStatistics, AllocationPhaseCount> Phases{};
+
+	TrackingResource(pmr::memory_resource& up) noexcept
+		: upstream(up)
+	{}
+
+	YB_ATTR_nodiscard YB_PURE pmr::memory_resource&
+	GetUpstreamRef() const noexcept
+	{
+		return upstream;
+	}
+
+	void
+	PrintStatistics(std::ostream&) const;
+
+private:
+	void*
+	do_allocate(size_t, size_t) override;
+
+	void
+	do_deallocate(void*, size_t, size_t) override;
+
+	YB_ATTR_nodiscard YB_PURE bool
+	do_is_equal(const pmr::memory_resource&) const noexcept override;
+};
+
+
+// NOTE: The profiler sampling the frame records of the current actions once
+//	in every %Period calls. The samples are kept as the folded stacks, i.e.
+//	the frame names from the outermost one separated by ';', which are
+//	accepted by the flame graph tools.
+class SamplingProfiler final
+{
+private:
+	size_t countdown;
+	map<string, size_t> samples{};
+	vector<string> frames{};
+
+public:
+	size_t Period;
+
+	explicit
+	SamplingProfiler(size_t period = 1000) noexcept
+		: countdown(period), Period(period)
+	{
+		assert(period != 0 && "Invalid sampling period found.");
+	}
+
+	void
+	operator()(const Context&);
+
+	void
+	PrintFolded(std::ostream&) const;
+
+	void
+	Sample(const Context&);
+};
+
+
+class FileImageCache;
+
 class Interpreter final
 {
 public:
 	bool Echo = std::getenv("ECHO");
 	bool UseSourceLocation = !std::getenv("UNILANG_NO_SRCINFO");
+	bool UseStreaming = std::getenv("UNILANG_STREAMING");
 
 private:
+	// NOTE: This shall be declared before any objects using the resource.
+	YSLib::unique_ptr<pmr::memory_resource> p_resource;
 	string line{};
 	shared_ptr<Environment> p_ground{};
+	// NOTE: This is enabled by the environment variable %UNILANG_PROFILE.
+	YSLib::unique_ptr<SamplingProfiler> p_profiler{};
+	// NOTE: This is enabled by the environment variable %UNILANG_CACHE.
+	YSLib::unique_ptr<FileImageCache> p_cache{};
 
 public:
-	GlobalState Global{};
+	GlobalState Global{TermNode::allocator_type(&GetMemoryResourceRef())};
 	Context Main{Global};
 	TermNode Term{Global.Allocator};
-	Context::ReducerSequence Backtrace{Global.Allocator};
+	Context::ReducerSequence Backtrace{Main.GetReducerAllocator()};
 
+	// NOTE: The memory resource kind is specified by the environment variable
+	//	%UNILANG_MEMORY_RESOURCE, see %ParseMemoryResourceKind.
 	Interpreter();
+	explicit
+	Interpreter(MemoryResourceKind);
 	Interpreter(const Interpreter&) = delete;
+	~Interpreter();
+
+	YB_ATTR_nodiscard YB_PURE pmr::memory_resource&
+	GetMemoryResourceRef() const noexcept
+	{
+		return p_resource ? *p_resource
+			: Unilang::Deref(pmr::get_default_resource());
+	}
 
 	void
 	Evaluate(TermNode&);
 
 private:
+	ReductionStatus
+	ExecuteForms(FormReader&, Context&);
+
 	ReductionStatus
 	ExecuteOnce(Context&);
 
@@ -63,6 +199,16 @@ public:
 	YB_ATTR_nodiscard TermNode
 	Read(string_view);
 
+	// NOTE: The file is mapped and read in place. The current source is set as
+	//	%OpenUnique.
+	YB_ATTR_nodiscard TermNode
+	ReadFile(Context&, string);
+
+	// NOTE: The file is read and preprocessed, or restored from the file cache
+	//	if available. The current source is set as %OpenUnique.
+	YB_ATTR_nodiscard TermNode
+	ReadFilePreprocessed(Context&, string);
+
 	void
 	Run();
 
@@ -94,6 +240,11 @@ PrintTermNode(std::ostream&, const TermNode&);
 void
 WriteTermValue(std::ostream&, const TermNode&);
 
+// NOTE: See Main.cpp for the definition. This initializes the ground
+//	environment with the standard library, as the interpreter program does.
+void
+LoadStandardLibrary(Interpreter&, int&, char*[]);
+
 } // namespace Unilang;
 
 #endif
@@ -170,6 +170,39 @@ IsUnilangSymbol(string_view id) noexcept
 }
 
 
+// NOTE: The leaf kinds have the same values to %LexemeCategory.
+enum class TokenKind : yimpl(unsigned char)
+{
+	Symbol = int(LexemeCategory::Symbol),
+	Code = int(LexemeCategory::Code),
+	Data = int(LexemeCategory::Data),
+	Extended = int(LexemeCategory::Extended),
+	LeftParenthesis,
+	RightParenthesis,
+	LeftBracket,
+	RightBracket,
+	LeftBrace,
+	RightBrace
+};
+
+
+YB_ATTR_nodiscard YB_STATELESS constexpr bool
+IsLeafToken(TokenKind kind) noexcept
+{
+	return kind < TokenKind::LeftParenthesis;
+}
+
+YB_ATTR_nodiscard YB_PURE TokenKind
+ClassifyLexeme(string_view) noexcept;
+
+YB_ATTR_nodiscard YB_STATELESS inline LexemeCategory
+ToLexemeCategory(TokenKind kind) noexcept
+{
+	assert(IsLeafToken(kind) && "Invalid token kind found.");
+	return LexemeCategory(kind);
+}
+
+
 YB_NORETURN void
 ThrowMismatchBoundaryToken(char, char);
 
@@ -4,7 +4,8 @@
 #define INC_Unilang_Parser_h_ 1
 
 #include "Lexical.h" // for lref, LexicalAnalyzer, pmr::polymorphic_allocator,
-//	string, pmr, std::swap, vector;
+//	string, pmr, std::swap, vector, string_view, pair, SourceLocation,
+//	TokenKind, ClassifyLexeme;
 #include <ystdex/type_traits.hpp> // for ystdex::remove_reference_t;
 #include <ystdex/ref.hpp> // for ystdex::unwrap_ref_decay_t;
 #include <ystdex/meta.hpp> // for ystdex::detected_or_t,
@@ -136,6 +137,11 @@ public:
 	{
 		return lexemes;
 	}
+	ParseResult&
+	GetResultRef() noexcept
+	{
+		return lexemes;
+	}
 
 private:
 	void
@@ -214,6 +220,11 @@ public:
 	{
 		return lexemes;
 	}
+	ParseResult&
+	GetResultRef() noexcept
+	{
+		return lexemes;
+	}
 	const SourceLocation&
 	GetSourceLocation() const noexcept
 	{
@@ -239,6 +250,80 @@ public:
 };
 
 
+struct LexemeToken final
+{
+	string_view Lexeme;
+	TokenKind Kind;
+};
+
+YB_ATTR_nodiscard YB_PURE inline LexemeToken
+MakeLexemeToken(string_view lexeme) noexcept
+{
+	return {lexeme, ClassifyLexeme(lexeme)};
+}
+
+
+// NOTE: The parsers below scan a contiguous source in place. The lexemes are
+//	slices of the source, which shall be kept alive until the lexemes are no
+//	longer used. The boundaries of the lexemes are same to %ByteParser, but
+//	the escape sequences in the literals are kept unhandled in the slices, see
+//	%UnescapeLexeme. A backslash out of the literals is not supported, and the
+//	call to the parser returns false. A byte parser should be used instead.
+//	The lexemes are classified when they are added.
+class ViewParser final
+{
+public:
+	using ParseResult = vector<LexemeToken>;
+
+private:
+	ParseResult lexemes;
+
+public:
+	ViewParser(pmr::polymorphic_allocator<yimpl(byte)> a = {})
+		: lexemes(a)
+	{}
+
+	YB_ATTR_nodiscard bool
+	operator()(string_view);
+
+	const ParseResult&
+	GetResult() const noexcept
+	{
+		return lexemes;
+	}
+};
+
+
+class SourcedViewParser final
+{
+public:
+	using ParseResult = vector<pair<SourceLocation, LexemeToken>>;
+
+private:
+	ParseResult lexemes;
+
+public:
+	SourcedViewParser(pmr::polymorphic_allocator<yimpl(byte)> a = {})
+		: lexemes(a)
+	{}
+
+	YB_ATTR_nodiscard bool
+	operator()(string_view);
+
+	const ParseResult&
+	GetResult() const noexcept
+	{
+		return lexemes;
+	}
+};
+
+
+// NOTE: This handles the escape sequences in the lexeme sliced by the view
+//	parsers, as %ByteParser does.
+YB_ATTR_nodiscard string
+UnescapeLexeme(string_view, pmr::polymorphic_allocator<yimpl(byte)> = {});
+
+
 template<class _type, yimpl(
 	typename = ystdex::enable_if_convertible_t<const _type&, const string&>)>
 YB_ATTR_nodiscard YB_STATELESS const _type&
@@ -251,6 +336,33 @@ ToLexeme(const SourcedByteParser::ParseResult::value_type& val) noexcept
 {
 	return val.second;
 }
+YB_ATTR_nodiscard YB_PURE inline const string_view&
+ToLexeme(const LexemeToken& val) noexcept
+{
+	return val.Lexeme;
+}
+YB_ATTR_nodiscard YB_PURE inline const string_view&
+ToLexeme(const SourcedViewParser::ParseResult::value_type& val) noexcept
+{
+	return val.second.Lexeme;
+}
+
+template<class _type>
+YB_ATTR_nodiscard YB_PURE inline TokenKind
+ClassifyToken(const _type& val) noexcept
+{
+	return ClassifyLexeme(YSLib::make_string_view(ToLexeme(val)));
+}
+YB_ATTR_nodiscard YB_PURE inline TokenKind
+ClassifyToken(const LexemeToken& val) noexcept
+{
+	return val.Kind;
+}
+YB_ATTR_nodiscard YB_PURE inline TokenKind
+ClassifyToken(const SourcedViewParser::ParseResult::value_type& val) noexcept
+{
+	return val.second.Kind;
+}
 
 } // namespace Unilang;
 
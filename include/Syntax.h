@@ -3,11 +3,11 @@
 #ifndef INC_Unilang_Syntax_h_
 #define INC_Unilang_Syntax_h_ 1
 
-#include "Parser.h" // for ToLexeme, ThrowMismatchBoundaryToken;
+#include "Parser.h" // for ToLexeme, ClassifyToken, TokenKind,
+//	ThrowMismatchBoundaryToken;
 #include "TermNode.h" // for TermNode, stack;
 #include "Exception.h" // for UnilangException;
 #include <cassert> // for assert;
-#include <ystdex/type_traits.hpp> // for ystdex::remove_reference_t;
 
 namespace Unilang
 {
@@ -59,39 +59,47 @@ ReduceSyntax(TermNode& term, _tIn first, _tIn last, _fTokenize tokenize)
 	for(; first != last; ++first)
 	{
 		const auto& val(*first);
-		const auto& lexeme(ToLexeme(val));
+		const auto kind(ClassifyToken(val));
 
-		if(lexeme == "(" || lexeme == "[" || lexeme == "{")
+		switch(kind)
 		{
+		case TokenKind::LeftParenthesis:
+		case TokenKind::LeftBracket:
+		case TokenKind::LeftBrace:
 			tms.push(AsTermNode(a));
-			tms.top().Value = lexeme;
-		}
-		else if(!(lexeme == ")" || lexeme == "]" || lexeme == "}"))
-		{
+			// NOTE: The kind of the left boundary is kept for the matching.
+			tms.top().Value = kind;
+			break;
+		case TokenKind::RightParenthesis:
+		case TokenKind::RightBracket:
+		case TokenKind::RightBrace:
+			if(tms.size() != 1)
+			{
+				auto tm(std::move(tms.top()));
+
+				tms.pop();
+
+				const auto ltok(tm.Value.GetObject<TokenKind>());
+
+				if(kind == TokenKind::RightParenthesis
+					&& ltok != TokenKind::LeftParenthesis)
+					ThrowMismatchBoundaryToken('(', ')');
+				if(kind == TokenKind::RightBracket
+					&& ltok != TokenKind::LeftBracket)
+					ThrowMismatchBoundaryToken('[', ']');
+				if(kind == TokenKind::RightBrace
+					&& ltok != TokenKind::LeftBrace)
+					ThrowMismatchBoundaryToken('{', '}');
+				tm.Value.Clear();
+				assert(!tms.empty());
+				tms.top().Add(std::move(tm));
+				break;
+			}
+			return first;
+		default:
 			assert(!tms.empty());
 			tms.top().Add(tokenize(val));
 		}
-		else if(tms.size() != 1)
-		{
-			auto tm(std::move(tms.top()));
-
-			tms.pop();
-
-			const auto& ltok(tm.Value.GetObject<
-				ystdex::remove_reference_t<decltype(lexeme)>>());
-
-			if(lexeme == ")" && ltok != "(")
-				ThrowMismatchBoundaryToken('(', ')');
-			if(lexeme == "]" && ltok != "[")
-				ThrowMismatchBoundaryToken('[', ']');
-			if(lexeme == "}" && ltok != "{")
-				ThrowMismatchBoundaryToken('{', '}');
-			tm.Value.Clear();
-			assert(!tms.empty());
-			tms.top().Add(std::move(tm));
-		}
-		else
-			return first;
 	}
 	if(tms.size() == 1)
 		return first;
@@ -101,6 +101,15 @@ struct RecordCompressor final
 	YB_ATTR_nodiscard YB_PURE static size_t
 	CountStrong(const shared_ptr<Environment>&) noexcept;
 
+	// NOTE: Check whether %Compress may collect anything with the environment
+	//	as the root, without building the universe. If the environment has
+	//	only one parent, the parent is only referenced by the edge from the
+	//	root in the parent graph. All environments reachable from an
+	//	externally referenced one are reachable, so the result is exact in
+	//	this case. Otherwise, the result is conservative.
+	YB_ATTR_nodiscard static bool
+	IsCompressible(Environment&);
+
 	template<typename _fTracer>
 	static void
 	Traverse(Environment& e, ValueObject& parent, const _fTracer& trace)
@@ -270,14 +279,18 @@ public:
 		return std::get<ActiveCombiner>(record_list.front());
 	}
 
+	// NOTE: The number of the removed records is added to
+	//	%Context::CompressedFrameRecords, and %Context::MaxFrameRecords is
+	//	updated by the number of the records kept.
 	void
-	CompressFrameList();
+	CompressFrameList(Context&);
 
 	void
 	CompressForContext(Context& ctx)
 	{
-		CompressFrameList();
-		RecordCompressor(ctx.GetRecordPtr()).Compress();
+		CompressFrameList(ctx);
+		if(RecordCompressor::IsCompressible(ctx.GetRecordRef()))
+			RecordCompressor(ctx.GetRecordPtr()).Compress();
 	}
 
 	void
@@ -20,6 +20,17 @@ namespace Unilang
 #endif
 
 
+// NOTE: The identifier of an interned symbol name. The value 0 is reserved for
+//	names not interned yet.
+using SymbolAtom = size_t;
+
+// NOTE: The symbol table is global and never shrinks. It is safe to be called
+//	concurrently. The global lock is only acquired for the names first
+//	interned by the calling thread.
+YB_ATTR_nodiscard SymbolAtom
+InternSymbol(string_view);
+
+
 // NOTE: The host type of symbol.
 // XXX: The destructor is not virtual.
 class TokenValue final : public string
@@ -27,6 +38,12 @@ class TokenValue final : public string
 public:
 	using base = string;
 
+private:
+	// NOTE: The cached atom of the name. Modifications on the base subobject
+	//	shall not occur after the atom is cached.
+	mutable SymbolAtom atom = 0;
+
+public:
 	TokenValue() = default;
 	using base::base;
 	TokenValue(const base& b)
@@ -42,6 +59,14 @@ public:
 	operator=(const TokenValue&) = default;
 	TokenValue&
 	operator=(TokenValue&&) = default;
+
+	YB_ATTR_nodiscard SymbolAtom
+	GetAtom() const
+	{
+		if(atom == 0)
+			atom = InternSymbol(*this);
+		return atom;
+	}
 };
 
 YB_ATTR_nodiscard YB_PURE string
@@ -11,6 +11,11 @@ Unilang_BaseDir="$(cd "$(dirname "${BASH_SOURCE[0]}")"; pwd)"
 
 . "$Unilang_BaseDir/detect-llvm.sh"
 
+# NOTE: The build identifier is used to check the term images, see
+#	src/Image.cpp.
+: "${Unilang_BuildId:=$(git -C "$Unilang_BaseDir" describe --always --dirty \
+	2> /dev/null || echo unknown)}"
+
 CXXFLAGS_Qt="$(pkg-config --cflags Qt5Widgets Qt5Quick)"
 LIBS_Qt="$(pkg-config --libs Qt5Widgets Qt5Quick)"
 
@@ -34,7 +39,9 @@ case $(uname) in
 esac
 mkdir -p "$Unilang_BaseDir/build"
 (cd "$Unilang_BaseDir/build" && SHBuild_NoAdjustSubsystem=true \
-	SHBuild_CXXFLAGS="$CXXFLAGS_EXTRA" SHBuild_LDFLAGS="$LDFLAGS_LOWBASE_" \
+	SHBuild_CXXFLAGS="$CXXFLAGS_EXTRA \
+-DUnilang_BuildId=\\\"$Unilang_BuildId\\\"" \
+	SHBuild_LDFLAGS="$LDFLAGS_LOWBASE_" \
 	SHBuild_LIBS="$LIBS_EXTRA" SHBuild-BuildPkg.sh "$@" \
 	-xn,unilang "$Unilang_BaseDir/src" -I\""$Unilang_BaseDir/include"\" \
 	"$CXXFLAGS_Qt")
@@ -10,16 +10,29 @@
 #include <ystdex/utility.hpp> // ystdex::exchange;
 #include "Evaluation.h" // for ReduceOnce;
 #include <ystdex/scope_guard.hpp> // for ystdex::make_guard;
-#include "TermAccess.h" // for Unilang::IsMovable;
+#include "TermAccess.h" // for Unilang::IsMovable, InternSymbol;
 #include "Forms.h" // for Forms::Sequence, ReduceBranchToList;
 #include "Evaluation.h" // for Strict;
-#include <ystdex/functor.hpp> // for ystdex::id;
-#include <algorithm> // for std::find_if;
-#include "Syntax.h" // for ReduceSyntax;
+#include <climits> // for CHAR_BIT;
+#include <algorithm> // for std::find_if, std::sort, std::lower_bound,
+//	std::upper_bound, std::binary_search, std::all_of;
+#include <functional> // for std::less;
+#include "Syntax.h" // for ReduceSyntax, ClassifyToken, TokenKind, ToLexeme;
+#include <cstddef> // for std::ptrdiff_t;
+#include <cstdint> // for std::uintptr_t;
 
 namespace Unilang
 {
 
+AllocationPhase&
+FetchAllocationPhaseRef() noexcept
+{
+	static thread_local AllocationPhase phase(AllocationPhase::Other);
+
+	return phase;
+}
+
+
 EnvironmentReference::EnvironmentReference(const shared_ptr<Environment>& p_env)
 	noexcept
 	: EnvironmentReference(p_env, p_env ? p_env->GetAnchorPtr() : nullptr)
@@ -31,13 +44,17 @@ namespace
 struct AnchorData final
 {
 public:
-	AnchorData() = default;
-	AnchorData(AnchorData&&) = default;
-
-	AnchorData&
-	operator=(AnchorData&&) = default;
+	// NOTE: The version of the environment, see %Environment::NotifyModified.
+	//	Like the bindings, it is not modified concurrently.
+	mutable size_t Version = 0;
 };
 
+YB_ATTR_nodiscard YB_PURE inline size_t
+FetchAnchorVersion(const void* p) noexcept
+{
+	return static_cast<const AnchorData*>(p)->Version;
+}
+
 
 #if Unilang_CheckParentEnvironment
 YB_ATTR_nodiscard YB_PURE bool
@@ -68,6 +85,37 @@ RedirectToShared(string_view id, shared_ptr<Environment> p_env)
 }
 
 
+// NOTE: The minimal number of bindings to enable the atom index.
+constexpr const size_t AtomIndexThreshold(8);
+
+YB_ATTR_nodiscard YB_PURE inline bool
+LessAtom(const Environment::AtomIndex::value_type& x,
+	const Environment::AtomIndex::value_type& y) noexcept
+{
+	return x.first < y.first;
+}
+
+
+// NOTE: The number of the entries of the resolution cache.
+constexpr const size_t ResolutionCacheSize(128);
+
+YB_ATTR_nodiscard YB_PURE const AnchorPtr*
+FetchResolutionKey(const ValueObject& parent) noexcept
+{
+	if(const auto p = parent.AccessPtr<EnvironmentReference>())
+		return p->GetAnchorPtr() ? &p->GetAnchorPtr() : nullptr;
+	if(const auto p = parent.AccessPtr<shared_ptr<Environment>>())
+		return *p && (*p)->GetAnchorPtr() ? &(*p)->GetAnchorPtr() : nullptr;
+	return {};
+}
+
+YB_ATTR_nodiscard YB_STATELESS size_t
+HashResolutionKey(const void* key, SymbolAtom atom) noexcept
+{
+	return (reinterpret_cast<std::uintptr_t>(key) >> 4) ^ (atom * 0x9E3779B1U);
+}
+
+
 using Redirector = function<const ValueObject*()>;
 
 const ValueObject*
@@ -86,14 +134,159 @@ RedirectEnvironmentList(EnvironmentList::const_iterator first,
 	return {};
 }
 
+template<typename _fLookup>
+Environment::NameResolution
+ResolveWith(_fLookup lookup, shared_ptr<Environment> p_env, string_view id)
+{
+	assert(bool(p_env));
+
+	Redirector cont;
+	// NOTE: Blocked. Use ISO C++14 deduced lambda return type (cf. CWG 975)
+	//	compatible to G++ attribute.
+	Environment::NameResolution::first_type p_obj;
+
+	do
+	{
+		p_obj = lookup(*p_env);
+	}while([&]() -> bool{
+		if(!p_obj)
+		{
+			lref<const ValueObject> cur(p_env->Parent);
+			shared_ptr<Environment> p_redirected{};
+			bool search_next;
+
+			do
+			{
+				const ValueObject& parent(cur);
+				const auto& tp(parent.type());
+
+				if(IsTyped<EnvironmentReference>(tp))
+				{
+					p_redirected = RedirectToShared(id,
+						parent.GetObject<EnvironmentReference>().Lock());
+					p_env.swap(p_redirected);
+				}
+				else if(IsTyped<shared_ptr<Environment>>(tp))
+				{
+					p_redirected = RedirectToShared(id,
+						parent.GetObject<shared_ptr<Environment>>());
+					p_env.swap(p_redirected);
+				}
+				else
+				{
+					const ValueObject* p_next = {};
+
+					if(IsTyped<EnvironmentList>(tp))
+					{
+						auto& envs(parent.GetObject<EnvironmentList>());
+
+						p_next = RedirectEnvironmentList(envs.cbegin(),
+							envs.cend(), id, cont);
+					}
+					while(!p_next && bool(cont))
+						p_next = ystdex::exchange(cont, Redirector())();
+					if(p_next)
+					{
+						// XXX: Cyclic parent found is not allowed.
+						assert(&cur.get() != p_next);
+						cur = *p_next;
+						search_next = true;
+						continue;
+					}
+				}
+				search_next = {};
+			}while(search_next);
+			return bool(p_redirected);
+		}
+		return false;
+	}());
+	return {p_obj, std::move(p_env)};
+}
+
 } // unnamed namespace;
 
+Environment::Environment(const Environment& e)
+	: Bindings(e.Bindings), Parent(e.Parent)
+{
+	for(size_t i(0); i < e.frame_size; ++i)
+	{
+		const auto& slot(e.AccessFrameSlot(i));
+
+		EmplaceFrameSlot(slot.Name, slot.Term, Bindings.get_allocator());
+	}
+}
+Environment::Environment(Environment&& e)
+	: Bindings(std::move(e.Bindings)), Parent(std::move(e.Parent)),
+	Frozen(e.Frozen), p_frame(e.p_frame), frame_size(e.frame_size),
+	p_anchor(std::move(e.p_anchor)), atom_index(std::move(e.atom_index))
+{
+	// NOTE: The allocator of %Bindings is moved, so the frame is deallocated
+	//	by the same resource.
+	yunseq(e.p_frame = {}, e.frame_size = 0);
+	NotifyModified();
+}
+Environment::~Environment()
+{
+	// NOTE: The anchor may outlive the environment.
+	NotifyModified();
+	ReleaseFrame();
+}
+
+Environment&
+Environment::operator=(Environment&& e)
+{
+	NotifyModified();
+	if(Bindings.get_allocator() == e.Bindings.get_allocator())
+	{
+		ReleaseFrame();
+		yunseq(p_frame = e.p_frame, frame_size = e.frame_size);
+		yunseq(e.p_frame = {}, e.frame_size = 0);
+	}
+	else
+	{
+		ClearFrame();
+		for(size_t i(0); i < e.frame_size; ++i)
+		{
+			auto& slot(e.AccessFrameSlot(i));
+
+			EmplaceFrameSlot(slot.Name, std::move(slot.Term),
+				Bindings.get_allocator());
+		}
+		e.ClearFrame();
+	}
+	Bindings = std::move(e.Bindings);
+	Parent = std::move(e.Parent);
+	Frozen = e.Frozen;
+	p_anchor = std::move(e.p_anchor);
+	NotifyModified();
+	// NOTE: The nodes of the bindings are not always moved, so the index is
+	//	invalidated.
+	atom_index.clear();
+	e.atom_index.clear();
+	return *this;
+}
+
+void
+Environment::AllocateFrame()
+{
+	assert(!p_frame && "Duplicate frame allocation found.");
+	p_frame = static_cast<FrameSlot*>(Bindings.get_allocator().resource()
+		->allocate(sizeof(FrameSlot) * FrameCapacity, alignof(FrameSlot)));
+}
+
 void
 Environment::CheckParent(const ValueObject&)
 {
 	// TODO: Check parent type.
 }
 
+void
+Environment::ClearFrame() noexcept
+{
+	for(; frame_size != 0; --frame_size)
+		AccessFrameSlot(frame_size - 1).~FrameSlot();
+}
+
 void
 Environment::DefineChecked(string_view id, ValueObject&& vo)
 {
@@ -110,6 +303,42 @@ Environment::EnsureValid(const shared_ptr<Environment>& p_env)
 	throw std::invalid_argument("Invalid environment found.");
 }
 
+TermNode*
+Environment::FindFrameSlot(string_view id) const noexcept
+{
+	assert(id.data());
+	for(size_t i(0); i < frame_size; ++i)
+	{
+		auto& slot(AccessFrameSlot(i));
+
+		if(string_view(slot.Name) == id)
+			return &slot.Term;
+	}
+	return {};
+}
+
+void
+Environment::IndexBinding(BindingMap::value_type& pr) const
+{
+	// NOTE: Only synchronized index is updated here. Otherwise, it would be
+	//	rebuilt on the next lookup.
+	if(Bindings.size() > AtomIndexThreshold
+		&& atom_index.size() + 1 == Bindings.size())
+	{
+		const AtomIndex::value_type val(InternSymbol(pr.first), &pr.second);
+
+		atom_index.insert(std::upper_bound(atom_index.begin(),
+			atom_index.end(), val, LessAtom), val);
+	}
+}
+
+void
+Environment::NotifyModified() const noexcept
+{
+	if(p_anchor)
+		++static_cast<const AnchorData*>(p_anchor.get())->Version;
+}
+
 AnchorPtr
 Environment::InitAnchor() const
 {
@@ -120,11 +349,62 @@ Environment::NameResolution::first_type
 Environment::LookupName(string_view id) const
 {
 	assert(id.data());
+	if(frame_size != 0)
+		if(const auto p = FindFrameSlot(id))
+			return p;
 
 	const auto i(Bindings.find(id));
 
 	return i != Bindings.cend() ? &i->second : nullptr;
 }
+Environment::NameResolution::first_type
+Environment::LookupName(SymbolAtom atom, string_view id) const
+{
+	assert(atom != 0 && "Invalid atom found.");
+	if(Bindings.size() < AtomIndexThreshold)
+		return LookupName(id);
+	// NOTE: The frame is only filled while %Bindings is empty, so it is empty
+	//	for most environments large enough to be indexed.
+	if(frame_size != 0)
+		if(const auto p = FindFrameSlot(id))
+			return p;
+	if(atom_index.size() != Bindings.size())
+	{
+		// NOTE: As the bindings are never removed, the indexed entries are
+		//	kept, and only the names of the bindings added directly to
+		//	%Bindings are interned.
+		using NodePtr = BindingMap::mapped_type*;
+		vector<NodePtr> indexed(atom_index.get_allocator());
+
+		indexed.reserve(atom_index.size());
+		for(const auto& val : atom_index)
+			indexed.push_back(val.second);
+		std::sort(indexed.begin(), indexed.end(), std::less<NodePtr>());
+		atom_index.reserve(Bindings.size());
+		for(auto& pr : Bindings)
+			if(!std::binary_search(indexed.begin(), indexed.end(), &pr.second,
+				std::less<NodePtr>()))
+				atom_index.emplace_back(InternSymbol(pr.first), &pr.second);
+		std::sort(atom_index.begin(), atom_index.end(), LessAtom);
+	}
+
+	const auto i(std::lower_bound(atom_index.cbegin(), atom_index.cend(),
+		AtomIndex::value_type(atom, nullptr), LessAtom));
+
+	return i != atom_index.cend() && i->first == atom ? i->second : nullptr;
+}
+
+void
+Environment::ReleaseFrame() noexcept
+{
+	if(p_frame)
+	{
+		ClearFrame();
+		Bindings.get_allocator().resource()->deallocate(p_frame,
+			sizeof(FrameSlot) * FrameCapacity, alignof(FrameSlot));
+		p_frame = {};
+	}
+}
 
 void
 Environment::ThrowForInvalidType(const type_info& tp)
@@ -150,6 +430,8 @@ ReductionStatus
 Context::ApplyTail()
 {
 	assert(IsAlive() && "No tail action found.");
+	if(YB_UNLIKELY(bool(TraceTail)))
+		TraceTail(*this);
 	TailAction = std::move(current.front());
 	current.pop_front();
 	try
@@ -180,75 +462,79 @@ Context::DefaultHandleException(std::exception_ptr p)
 
 Environment::NameResolution
 Context::Resolve(shared_ptr<Environment> p_env, string_view id) const
+{
+	return ResolveWith([=](const Environment& env){
+		return env.LookupName(id);
+	}, std::move(p_env), id);
+}
+Environment::NameResolution
+Context::Resolve(shared_ptr<Environment> p_env, SymbolAtom atom,
+	string_view id) const
 {
 	assert(bool(p_env));
+	if(const auto p = p_env->LookupName(atom, id))
+		return {p, std::move(p_env)};
 
-	Redirector cont;
-	// NOTE: Blocked. Use ISO C++14 deduced lambda return type (cf. CWG 975)
-	//	compatible to G++ attribute.
-	Environment::NameResolution::first_type p_obj;
-
-	do
+	if(const auto p_key_anchor = FetchResolutionKey(p_env->Parent))
 	{
-		p_obj = p_env->LookupName(id);
-	}while([&]() -> bool{
-		if(!p_obj)
-		{
-			lref<const ValueObject> cur(p_env->Parent);
-			shared_ptr<Environment> p_redirected{};
-			bool search_next;
-
-			do
+		const auto p_key(p_key_anchor->get());
+
+		if(resolution_cache.empty())
+			resolution_cache.resize(ResolutionCacheSize);
+
+		auto& entry(resolution_cache[HashResolutionKey(p_key, atom)
+			% resolution_cache.size()]);
+
+		// NOTE: The first anchor in the path is alive as it is the key. Each
+		//	following anchor is kept alive by the previous environments in the
+		//	path as long as their versions are not changed, since a version is
+		//	changed when %Parent is changed or the environment is destroyed.
+		if(entry.Atom == atom && entry.PathSize != 0
+			&& entry.Path[0].first == p_key && std::all_of(entry.Path.cbegin(),
+			entry.Path.cbegin() + entry.PathSize,
+			[](const pair<const void*, size_t>& pr) noexcept{
+				return FetchAnchorVersion(pr.first) == pr.second;
+			}))
+			if(auto p_target = entry.Target.lock())
 			{
-				const ValueObject& parent(cur);
-				const auto& tp(parent.type());
-
-				if(IsTyped<EnvironmentReference>(tp))
-				{
-					p_redirected = RedirectToShared(id,
-						parent.GetObject<EnvironmentReference>().Lock());
-					p_env.swap(p_redirected);
-				}
-				else if(IsTyped<shared_ptr<Environment>>(tp))
-				{
-					p_redirected = RedirectToShared(id,
-						parent.GetObject<shared_ptr<Environment>>());
-					p_env.swap(p_redirected);
-				}
-				else
-				{
-					const ValueObject* p_next = {};
-
-					if(IsTyped<EnvironmentList>(tp))
-					{
-						auto& envs(parent.GetObject<EnvironmentList>());
-
-						p_next = RedirectEnvironmentList(envs.cbegin(),
-							envs.cend(), id, cont);
-					}
-					while(!p_next && bool(cont))
-						p_next = ystdex::exchange(cont, Redirector())();
-					if(p_next)
-					{
-						// XXX: Cyclic parent found is not allowed.
-						assert(&cur.get() != p_next);
-						cur = *p_next;
-						search_next = true;
-						continue;
-					}
-				}
-				search_next = {};
-			}while(search_next);
-			return bool(p_redirected);
-		}
-		return false;
-	}());
-	return {p_obj, std::move(p_env)};
+				++ResolutionCacheHits;
+				return {entry.Bound, std::move(p_target)};
+			}
+		++ResolutionCacheMisses;
+
+		const auto p_start(p_env.get());
+		decltype(entry.Path) path;
+		size_t n(0);
+		bool uncached = {};
+		auto res(ResolveWith([&](const Environment& env)
+			-> Environment::NameResolution::first_type{
+			// NOTE: The starting environment has been looked up above.
+			if(&env == p_start)
+				return nullptr;
+			if(n < path.size() && env.GetAnchorPtr())
+				path[n++] = {env.GetAnchorPtr().get(),
+					FetchAnchorVersion(env.GetAnchorPtr().get())};
+			else
+				uncached = true;
+			return env.LookupName(atom, id);
+		}, std::move(p_env), id));
+
+		if(res.first && !uncached && n != 0 && path[0].first == p_key)
+			yunseq(entry.KeyAnchor = *p_key_anchor, entry.Atom = atom,
+				entry.PathSize = n, entry.Path = path, entry.Bound = res.first,
+				entry.Target = res.second);
+		return res;
+	}
+	return ResolveWith([=](const Environment& env){
+		return env.LookupName(atom, id);
+	}, std::move(p_env), id);
 }
 
 ReductionStatus
 Context::Rewrite(Reducer reduce)
 {
+	const AllocationPhaseGuard gd(AllocationPhase::Reduction);
+
 	SetupCurrent(std::move(reduce));
 	// NOTE: Rewrite until no actions remain.
 	do
@@ -275,7 +561,8 @@ Context::RewriteTerm(TermNode& term)
 {
 	AssertValueTags(term);
 	next_term_ptr = &term;
-	return Rewrite(Unilang::ToReducer(get_allocator(), std::ref(ReduceOnce)));
+	return Rewrite(
+		Unilang::ToReducer(GetReducerAllocator(), std::ref(ReduceOnce)));
 }
 
 ReductionStatus
@@ -284,7 +571,7 @@ Context::RewriteTermGuarded(TermNode& term)
 	AssertValueTags(term);
 	next_term_ptr = &term;
 	return RewriteGuarded(term,
-		Unilang::ToReducer(get_allocator(), std::ref(ReduceOnce)));
+		Unilang::ToReducer(GetReducerAllocator(), std::ref(ReduceOnce)));
 }
 
 shared_ptr<Environment>
@@ -415,55 +702,64 @@ struct SeparatorPass::TransformationSpec final
 		BinaryAssocRight
 	};
 
-	function<bool(const TermNode&)> Filter;
-	function<ValueObject(const ValueObject&)> MakePrefix;
+	vector<string_view> Delimiters;
+	// NOTE: The delimiter is used as the prefix if this is empty.
+	ValueObject Prefix;
 	SeparatorKind Kind;
 
-	TransformationSpec(decltype(Filter), decltype(MakePrefix),
+	TransformationSpec(std::initializer_list<string_view>, ValueObject,
 		SeparatorKind = NAry);
-	TransformationSpec(TokenValue, ValueObject, SeparatorKind = NAry);
+	TransformationSpec(std::initializer_list<string_view>, SeparatorKind);
+
+	YB_ATTR_nodiscard ValueObject
+	MakePrefix(const ValueObject& delim) const
+	{
+		return Prefix ? Prefix : delim;
+	}
 };
 
 SeparatorPass::TransformationSpec::TransformationSpec(
-	decltype(Filter) filter, decltype(MakePrefix) make_pfx, SeparatorKind kind)
-	: Filter(std::move(filter)), MakePrefix(std::move(make_pfx)), Kind(kind)
+	std::initializer_list<string_view> delims, ValueObject pfx,
+	SeparatorKind kind)
+	: Delimiters(delims), Prefix(std::move(pfx)), Kind(kind)
 {}
-SeparatorPass::TransformationSpec::TransformationSpec(TokenValue delim,
-	ValueObject pfx, SeparatorKind kind)
-	: TransformationSpec(ystdex::bind1(HasValue<TokenValue>, delim),
-		[=](const ValueObject&){
-		return pfx;
-	}, kind)
+SeparatorPass::TransformationSpec::TransformationSpec(
+	std::initializer_list<string_view> delims, SeparatorKind kind)
+	: TransformationSpec(delims, ValueObject(), kind)
 {}
 
 SeparatorPass::SeparatorPass(TermNode::allocator_type a)
-	: allocator(a), transformations({{";", ContextHandler(Forms::Sequence)},
-	{",", ContextHandler(FormContextHandler(ReduceBranchToList, Strict))},
-	{[](const TermNode& nd) noexcept{
-		return HasValue<TokenValue>(nd, ":=");
-	}, [](const ValueObject&){
-		return TokenValue("assign!");
-	}, TransformationSpec::BinaryAssocRight},
-	{[](const TermNode& nd) noexcept{
-		return HasValue<TokenValue>(nd, "=") || HasValue<TokenValue>(nd, "!=");
-	}, ystdex::id<>(), TransformationSpec::BinaryAssocLeft},
-	{[](const TermNode& nd) noexcept{
-		return HasValue<TokenValue>(nd, "<") || HasValue<TokenValue>(nd, ">")
-			|| HasValue<TokenValue>(nd, "<=") || HasValue<TokenValue>(nd, ">=");
-	}, ystdex::id<>(), TransformationSpec::BinaryAssocLeft},
-	{[](const TermNode& nd) noexcept{
-		return HasValue<TokenValue>(nd, "+") || HasValue<TokenValue>(nd, "-"); 
-	}, ystdex::id<>(), TransformationSpec::BinaryAssocLeft},
-	{[](const TermNode& nd) noexcept{
-		return HasValue<TokenValue>(nd, "*") || HasValue<TokenValue>(nd, "/"); 
-	}, ystdex::id<>(), TransformationSpec::BinaryAssocLeft}}, a)
-{}
+	: allocator(a), transformations({{{";"}, ContextHandler(Forms::Sequence)},
+	{{","}, ContextHandler(FormContextHandler(ReduceBranchToList, Strict))},
+	{{":="}, TokenValue("assign!"), TransformationSpec::BinaryAssocRight},
+	{{"=", "!="}, TransformationSpec::BinaryAssocLeft},
+	{{"<", ">", "<=", ">="}, TransformationSpec::BinaryAssocLeft},
+	{{"+", "-"}, TransformationSpec::BinaryAssocLeft},
+	{{"*", "/"}, TransformationSpec::BinaryAssocLeft}}, a)
+{
+	assert(transformations.size() <= sizeof(SpecMask) * CHAR_BIT
+		&& "Too many transformations found.");
+	// NOTE: The table is indexed by the interned atoms of the delimiters, so
+	//	each leaf is classified by a single lookup.
+	for(size_t idx(0); idx != transformations.size(); ++idx)
+		for(const auto& delim : transformations[idx].Delimiters)
+		{
+			const auto atom(InternSymbol(delim));
+
+			if(atom >= atom_masks.size())
+				atom_masks.resize(atom + 1);
+			atom_masks[atom] |= SpecMask(1) << idx;
+		}
+}
 SeparatorPass::~SeparatorPass() = default;
 
 ReductionStatus
 SeparatorPass::operator()(TermNode& term) const
 {
 	assert(remained.empty() && "Invalid state found.");
+
+	const AllocationPhaseGuard gd(AllocationPhase::Preprocess);
+
 	Transform(term, {}, remained);
 	while(!remained.empty())
 	{
@@ -476,6 +772,48 @@ SeparatorPass::operator()(TermNode& term) const
 	return ReductionStatus::Clean;
 }
 
+size_t
+SeparatorPass::FindPrefix(const ValueObject& vo) const
+{
+	for(size_t idx(0); idx != transformations.size(); ++idx)
+	{
+		const auto& pfx(transformations[idx].Prefix);
+
+		if(pfx && pfx == vo)
+			return idx;
+	}
+	return size_t(-1);
+}
+
+const ValueObject&
+SeparatorPass::GetPrefix(size_t idx) const
+{
+	return transformations.at(idx).Prefix;
+}
+
+SeparatorPass::SpecMask
+SeparatorPass::Classify(const TermNode& nd) const
+{
+	if(const auto p = TryAccessValue<TokenValue>(nd.Value))
+	{
+		const auto atom(p->GetAtom());
+
+		if(atom < atom_masks.size())
+			return atom_masks[atom];
+	}
+	return 0;
+}
+
+SeparatorPass::SpecMask
+SeparatorPass::ClassifyChildren(const TermNode& term) const
+{
+	SpecMask mask(0);
+
+	for(const auto& nd : term)
+		mask |= Classify(nd);
+	return mask;
+}
+
 void
 SeparatorPass::Transform(TermNode& term, bool skip_binary,
 	SeparatorPass::TermStack& terms) const
@@ -485,17 +823,29 @@ SeparatorPass::Transform(TermNode& term, bool skip_binary,
 		if(IsEmpty(*term.begin()))
 			skip_binary = true;
 		terms.push({term, skip_binary});
-		for(const auto& trans : transformations)
-		{
-			const auto& filter(trans.Filter);
-			auto i(std::find_if(term.begin(), term.end(), filter));
 
-			if(i != term.end())
+		// NOTE: The children are classified in a single scan. Most branches
+		//	have no delimiters and are skipped here. The term is only
+		//	rescanned after it has been transformed.
+		auto mask(ClassifyChildren(term));
+
+		for(size_t idx(0); mask != 0 && idx != transformations.size(); ++idx)
+			if(mask & (SpecMask(1) << idx))
+			{
+				const auto& trans(transformations[idx]);
+				const auto bit(SpecMask(1) << idx);
+				const auto filter([&, bit](const TermNode& nd){
+					return (Classify(nd) & bit) != 0;
+				});
+				auto i(std::find_if(term.begin(), term.end(), filter));
+
+				assert(i != term.end());
 				switch(trans.Kind)
 				{
 				case TransformationSpec::NAry:
 					term = SeparatorTransformer::Process(std::move(term),
 						trans.MakePrefix(i->Value), filter);
+					mask = ClassifyChildren(term);
 					break;
 				case TransformationSpec::BinaryAssocLeft:
 				case TransformationSpec::BinaryAssocRight:
@@ -541,29 +891,50 @@ SeparatorPass::Transform(TermNode& term, bool skip_binary,
 						range_add(std::make_move_iterator(term.begin()), im);
 						range_add(++im, std::make_move_iterator(term.end()));
 						term = std::move(res);
+						mask = ClassifyChildren(term);
 					}
 				}
-		}
+			}
 	}
 }
 
 
+Tokenizer
+AdaptTokenizer(ByteTokenizer f)
+{
+	return [f](const GParsedValue<ViewParser>& tok) -> TermNode{
+		return f(GParsedValue<ByteParser>(tok.Lexeme.data(),
+			tok.Lexeme.size()));
+	};
+}
+
+SourcedTokenizer
+AdaptSourcedTokenizer(SourcedByteTokenizer f)
+{
+	return [f](const GParsedValue<SourcedViewParser>& val, Context& ctx)
+		-> TermNode{
+		return f(GParsedValue<SourcedByteParser>(val.first,
+			GParsedValue<ByteParser>(val.second.Lexeme.data(),
+			val.second.Lexeme.size())), ctx);
+	};
+}
+
+
 GlobalState::GlobalState(TermNode::allocator_type a)
-	: Allocator(a), ConvertLeaf([this](const GParsedValue<ByteParser>& str){
+	: Allocator(a), ConvertLeaf([this](const GParsedValue<ViewParser>& tok){
 	TermNode term(Allocator);
-	const auto id(YSLib::make_string_view(str));
 
-	if(!id.empty())
-		ParseLeaf(term, id);
+	if(!tok.Lexeme.empty())
+		ParseLeaf(term, tok.Lexeme, ToLexemeCategory(tok.Kind));
 	return term;
-}), ConvertLeafSourced([this](const GParsedValue<SourcedByteParser>& val,
+}), ConvertLeafSourced([this](const GParsedValue<SourcedViewParser>& val,
 	const Context& ctx){
 	TermNode term(Allocator);
-	const auto id(YSLib::make_string_view(val.second));
+	const auto& tok(val.second);
 
-	if(!id.empty())
-		ParseLeafWithSourceInformation(term, id, ctx.CurrentSource,
-			val.first);
+	if(!tok.Lexeme.empty())
+		ParseLeafWithSourceInformation(term, tok.Lexeme, ctx.CurrentSource,
+			val.first, ToLexemeCategory(tok.Kind));
 	return term;
 })
 {}
@@ -571,6 +942,31 @@ GlobalState::GlobalState(TermNode::allocator_type a)
 TermNode
 GlobalState::Read(string_view unit, Context& ctx)
 {
+	const AllocationPhaseGuard gd(AllocationPhase::Parse);
+
+	return ReadInPlace(unit, ctx);
+}
+
+TermNode
+GlobalState::ReadInPlace(string_view unit, Context& ctx) const
+{
+	if(UseSourceLocation)
+	{
+		SourcedViewParser parse(Allocator);
+
+		if(parse(unit))
+			return PrepareLexemes(ctx, parse.GetResult());
+	}
+	else
+	{
+		ViewParser parse(Allocator);
+
+		if(parse(unit))
+			return PrepareLexemes(ctx, parse.GetResult());
+	}
+
+	// NOTE: There are backslashes out of the literals. The byte parsers are
+	//	used instead.
 	LexicalAnalyzer lexer;
 
 	if(UseSourceLocation)
@@ -586,6 +982,7 @@ TermNode
 GlobalState::ReadFrom(std::streambuf& buf, Context& ctx) const
 {
 	using s_it_t = std::istreambuf_iterator<char>;
+	const AllocationPhaseGuard gd(AllocationPhase::Parse);
 	LexicalAnalyzer lexer;
 
 	if(UseSourceLocation)
@@ -609,5 +1006,116 @@ GlobalState::ReadFrom(std::istream& is, Context& ctx) const
 		throw std::invalid_argument("Invalid stream found.");
 }
 
+
+FormReader::FormReader(const GlobalState& global, std::streambuf& buf,
+	Context& ctx)
+	: global_ref(global), context_ref(ctx), source(ctx.CurrentSource),
+	current(&buf), parse(lexer, global.Allocator),
+	parse_sourced(lexer, global.Allocator)
+{}
+
+bool
+FormReader::Read(TermNode& term)
+{
+	if(!finished)
+	{
+		const AllocationPhaseGuard gd(AllocationPhase::Parse);
+
+		// NOTE: The source name may have been changed by the evaluation of the
+		//	previous form, e.g. by 'load'.
+		context_ref.get().CurrentSource = source;
+		if(global_ref.get().UseSourceLocation)
+			return ReadWith(term, parse_sourced);
+		return ReadWith(term, parse);
+	}
+	return {};
+}
+
+template<class _tParser>
+bool
+FormReader::ReadWith(TermNode& term, _tParser& parse_ref)
+{
+	auto& lexemes(parse_ref.GetResultRef());
+
+	while(true)
+	{
+		// NOTE: The last lexeme is not scanned until it is completed. The
+		//	delimiters are always completed once added.
+		const auto n(lexemes.size() - (parse_ref.IsUpdating() ? 1 : 0));
+
+		for(; scanned < n; ++scanned)
+		{
+			const auto& val(lexemes[scanned]);
+
+			switch(ClassifyToken(val))
+			{
+			case TokenKind::LeftParenthesis:
+			case TokenKind::LeftBracket:
+			case TokenKind::LeftBrace:
+				++depth;
+				continue;
+			case TokenKind::RightParenthesis:
+			case TokenKind::RightBracket:
+			case TokenKind::RightBrace:
+				if(depth == 0)
+					throw UnilangException("Redundant ')', ']' or '}' found.");
+				--depth;
+				continue;
+			default:
+				break;
+			}
+			if(depth == 0 && ToLexeme(val) == ";")
+			{
+				separated = true;
+				if(TakeForm(term, parse_ref, scanned))
+					return true;
+				// NOTE: The form is empty. Since the lexemes are taken,
+				//	restart the scan.
+				break;
+			}
+		}
+		if(scanned == n)
+		{
+			if(current == std::istreambuf_iterator<char>())
+				break;
+			parse_ref(*current);
+			++current;
+		}
+	}
+	finished = true;
+	return TakeForm(term, parse_ref, lexemes.size());
+}
+
+template<class _tParser>
+bool
+FormReader::TakeForm(TermNode& term, _tParser& parse_ref, size_t n)
+{
+	auto& lexemes(parse_ref.GetResultRef());
+	const auto first(lexemes.begin());
+	const auto last(first + std::ptrdiff_t(n));
+	TermNode res(global_ref.get().Allocator);
+
+	if(ReduceSyntax(res, first, last,
+		GlobalState::LeafConverter{context_ref.get()}) != last)
+		throw UnilangException("Redundant ')', ']' or '}' found.");
+	lexemes.erase(first, last != lexemes.end() ? std::next(last) : last);
+	scanned = 0;
+	if(separated)
+	{
+		if(res.size() == 0)
+			return {};
+		if(res.size() == 1)
+		{
+			// NOTE: This is same to the transformation by the separator.
+			auto tm(MoveFirstSubterm(res));
+
+			term = std::move(tm);
+			return true;
+		}
+	}
+	term = std::move(res);
+	return true;
+}
+
 } // namespace Unilang;
 
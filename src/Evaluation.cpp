@@ -13,7 +13,8 @@
 //	YSLib::mutex, YSLib::unordered_map, type_index, std::allocator, std::pair,
 //	AssertValueTags;
 #include "TermAccess.h" // for ClearCombiningTags, TryAccessLeafAtom,
-//	TokenValue, AssertCombiningTerm, IsCombiningTerm, TryAccessTerm;
+//	TokenValue, AssertCombiningTerm, IsCombiningTerm, TryAccessTerm,
+//	TryAccessLeaf;
 #include <cassert> // for assert;
 #include "Math.h" // for ReadDecimal;
 #include <limits> // for std::numeric_limits;
@@ -39,6 +40,9 @@
 #include <ystdex/deref_op.hpp> // for ystdex::call_value_or;
 #include YFM_YSLib_Core_YException // for YSLib::FilterExceptions,
 //	YSLib::Notice;
+#include "Forms.h" // for Forms::If, Forms::Sequence, Forms::Cond, Forms::When,
+//	Forms::Unless, Forms::And, Forms::Or;
+#include <algorithm> // for std::stable_sort;
 
 namespace Unilang
 {
@@ -59,6 +63,20 @@ MakeSubobjectReferent(TermNode::allocator_type a, shared_ptr<TermNode> p_sub)
 	return Unilang::AsTermNodeTagged(a, TermTags::Sticky, std::move(p_sub));
 }
 
+void
+CopySharedSubterms(TermNode& term, const shared_ptr<const TermNode>& p_root,
+	const TermNode& nd)
+{
+	auto& con(term.GetContainerRef());
+
+	assert(con.empty() && "Invalid term found.");
+	for(const auto& sub : nd)
+		if(IsBranch(sub))
+			con.emplace_back(sub.Tags, NoContainer, SharedCode(p_root, sub));
+		else
+			con.emplace_back(sub.Tags, NoContainer, sub.Value);
+}
+
 
 class RefContextHandler final
 	: private ystdex::equality_comparable<RefContextHandler>
@@ -222,11 +240,13 @@ EnsureLValueReference(TermReference&& ref)
 }
 
 ReductionStatus
-EvaluateLeafToken(TermNode& term, Context& ctx, string_view id)
+EvaluateLeafToken(TermNode& term, Context& ctx, const TokenValue& tok)
 {
+	const string_view id(tok);
+
 	assert(id.data());
 
-	auto pr(ctx.Resolve(ctx.GetRecordPtr(), id));
+	auto pr(ctx.Resolve(ctx.GetRecordPtr(), tok.GetAtom(), id));
 
 	if(pr.first)
 	{
@@ -334,9 +354,68 @@ MakeGLContinuation(_func f) noexcept(noexcept(std::declval<_func>()))
 }
 
 
+YB_ATTR_nodiscard YB_PURE bool
+AcceptsSharedCode(const ContextHandler& h) noexcept
+{
+	if(const auto p = h.target<FormContextHandler>())
+	{
+		if(p->GetWrappingCount() != 0)
+			return true;
+		// XXX: These operatives only access their operands by the reduction,
+		//	except the clauses of '$cond', which are expanded by %Forms::Cond.
+		//	Other operatives, including the ones derived by '$vau', may access
+		//	the operands as objects, so the operands are materialized.
+		if(const auto p_f
+			= p->Handler.target<ReductionStatus(*)(TermNode&, Context&)>())
+			return *p_f == Forms::If || *p_f == Forms::Sequence
+				|| *p_f == Forms::Cond || *p_f == Forms::When
+				|| *p_f == Forms::Unless || *p_f == Forms::And
+				|| *p_f == Forms::Or;
+	}
+	return {};
+}
+
+YB_ATTR_nodiscard string
+MakeCombinerProfileKey(const ValueObject& op)
+{
+	if(const auto p = op.AccessPtr<TokenValue>())
+	{
+		if(const auto p_si = QuerySourceInformation(op))
+			return ystdex::sfmt<string>("%s (%s:%zu)", p->c_str(),
+				p_si->first ? p_si->first->c_str() : "<unknown>",
+				p_si->second.Line + 1);
+		return *p;
+	}
+	return "#[combiner]";
+}
+
+// NOTE: This shall be called just before the combiner call is set up. The
+//	frame of the action counting the time is kept until the call returns, so
+//	the calls are not proper tail calls during profiling, and the space of
+//	deep tail recursion grows with the depth only when profiled. This is
+//	documented for %std.profile. Counting the time without the frame would
+//	need the TCO action to merge the timings of the tail calls.
+void
+SetupCombinerProfile(Context& ctx, const ValueObject& op)
+{
+	const auto p_prof(ctx.CombinerProfilePtr);
+	auto& entry(p_prof->Entries[MakeCombinerProfileKey(op)]);
+	const auto start(std::chrono::steady_clock::now());
+
+	++entry.Calls;
+	ctx.SetupFront(Unilang::NameTypedReducerHandler(
+		[p_prof, &entry, start](Context& c) noexcept{
+		yunused(p_prof);
+		entry.Time += std::chrono::steady_clock::now() - start;
+		return c.LastStatus;
+	}, "profile-combiner"));
+}
+
 ReductionStatus
 CombinerReturnThunk(const ContextHandler& h, TermNode& term, Context& ctx)
 {
+	if(!AcceptsSharedCode(h))
+		MaterializeSharedCode(term);
 	ctx.ClearCombiningTerm();
 	ctx.SetNextTermRef(term);
 	return RelaySwitched(ctx, GLContinuation<>(h));
@@ -1270,6 +1349,7 @@ ReductionStatus
 Context::DefaultReduceOnce(TermNode& term, Context& ctx)
 {
 	AssertValueTags(term);
+	ExpandSharedCode(term);
 	return IsCombiningTerm(term) ? ReduceCombining(term, ctx)
 		: ReduceLeaf(term, ctx);
 }
@@ -1284,12 +1364,58 @@ ReduceOrdered(TermNode& term, Context& ctx)
 }
 
 
+void
+SetSharedContent(TermNode& term, const shared_ptr<const TermNode>& p_root)
+{
+	const auto& nd(Unilang::Deref(p_root));
+
+	term.GetContainerRef().clear();
+	term.Value = nd.Value;
+	term.Tags = nd.Tags;
+	CopySharedSubterms(term, p_root, nd);
+}
+
+void
+ExpandSharedCode(TermNode& term)
+{
+	if(const auto p = TryAccessLeaf<const SharedCode>(term))
+	{
+		// NOTE: The root shall be retained before the value is replaced.
+		const auto p_root(p->GetRootPtr());
+		const auto& nd(p->get());
+
+		term.Value = nd.Value;
+		CopySharedSubterms(term, p_root, nd);
+	}
+}
+
+void
+MaterializeSharedCode(TermNode& term)
+{
+	for(auto& sub : term)
+		if(const auto p = TryAccessLeaf<const SharedCode>(sub))
+		{
+			const auto p_root(p->GetRootPtr());
+
+			sub.SetContent(p->get());
+		}
+		else if(IsBranch(sub))
+			MaterializeSharedCode(sub);
+}
+
+
 void
 ParseLeaf(TermNode& term, string_view id)
+{
+	ParseLeaf(term, id, CategorizeBasicLexeme(id));
+}
+void
+ParseLeaf(TermNode& term, string_view id, LexemeCategory category)
 {
 	assert(id.data());
 	assert(!id.empty() && "Invalid leaf token found.");
-	switch(CategorizeBasicLexeme(id))
+	assert(category == CategorizeBasicLexeme(id) && "Invalid category found.");
+	switch(category)
 	{
 	case LexemeCategory::Code:
 		id = DeliteralizeUnchecked(id);
@@ -1297,7 +1423,10 @@ ParseLeaf(TermNode& term, string_view id)
 		break;
 	case LexemeCategory::Symbol:
 		if(ParseSymbol(term, id))
+		{
 			term.SetValue(in_place_type<TokenValue>, id, term.get_allocator());
+			yunused(term.Value.GetObject<TokenValue>().GetAtom());
+		}
 		break;
 	case LexemeCategory::Data:
 		term.SetValue(in_place_type<string>, Deliteralize(id),
@@ -1311,30 +1440,53 @@ ParseLeaf(TermNode& term, string_view id)
 void
 ParseLeafWithSourceInformation(TermNode& term, string_view id,
 	const shared_ptr<string>& name, const SourceLocation& src_loc)
+{
+	ParseLeafWithSourceInformation(term, id, name, src_loc,
+		CategorizeBasicLexeme(id));
+}
+void
+ParseLeafWithSourceInformation(TermNode& term, string_view id,
+	const shared_ptr<string>& name, const SourceLocation& src_loc,
+	LexemeCategory category)
 {
 	assert(id.data());
 	assert(!id.empty() && "Invalid leaf token found.");
-	switch(CategorizeBasicLexeme(id))
+	assert(category == CategorizeBasicLexeme(id) && "Invalid category found.");
+	switch(category)
 	{
 	case LexemeCategory::Code:
-		id = DeliteralizeUnchecked(id);
-		term.SetValue(any_ops::use_holder, in_place_type<SourcedHolder<
-			TokenValue>>, name, src_loc, id, term.get_allocator());
+		SetSourcedToken(term, DeliteralizeUnchecked(id), name, src_loc);
 		break;
 	case LexemeCategory::Symbol:
 		if(ParseSymbol(term, id))
-			term.SetValue(any_ops::use_holder, in_place_type<SourcedHolder<
-				TokenValue>>, name, src_loc, id, term.get_allocator());
+		{
+			SetSourcedToken(term, id, name, src_loc);
+			yunused(term.Value.GetObject<TokenValue>().GetAtom());
+		}
 		break;
 	case LexemeCategory::Data:
-		term.SetValue(any_ops::use_holder, in_place_type<SourcedHolder<string>>,
-			name, src_loc, Deliteralize(id), term.get_allocator());
+		SetSourcedString(term, Deliteralize(id), name, src_loc);
 		YB_ATTR_fallthrough;
 	default:
 		break;
 	}
 }
 
+void
+SetSourcedToken(TermNode& term, string_view id, const shared_ptr<string>& name,
+	const SourceLocation& src_loc)
+{
+	term.SetValue(any_ops::use_holder, in_place_type<SourcedHolder<
+		TokenValue>>, name, src_loc, id, term.get_allocator());
+}
+void
+SetSourcedString(TermNode& term, string_view str,
+	const shared_ptr<string>& name, const SourceLocation& src_loc)
+{
+	term.SetValue(any_ops::use_holder, in_place_type<SourcedHolder<string>>,
+		name, src_loc, str, term.get_allocator());
+}
+
 
 ReductionStatus
 FormContextHandler::CallHandler(TermNode& term, Context& ctx) const
@@ -1450,10 +1602,10 @@ ReduceForCombinerRef(TermNode& term, const TermReference& ref,
 ReductionStatus
 ReduceLeaf(TermNode& term, Context& ctx)
 {
-	const auto res(ystdex::call_value_or([&](string_view id){
+	const auto res(ystdex::call_value_or([&](const TokenValue& tok){
 		try
 		{
-			return EvaluateLeafToken(term, ctx, id);
+			return EvaluateLeafToken(term, ctx, tok);
 		}
 		catch(BadIdentifier& e)
 		{
@@ -1480,7 +1632,12 @@ ReduceCombinedBranch(TermNode& term, Context& ctx)
 		if(const auto p_handler
 			= TryAccessLeafAtom<const ContextHandler>(p_ref_fm->get()))
 		{
-			EnsureTCOAction(ctx, term).AddOperator(ctx.OperatorName);
+			auto& act(EnsureTCOAction(ctx, term));
+
+			act.AddOperator(ctx.OperatorName);
+			if(YB_UNLIKELY(bool(ctx.CombinerProfilePtr)))
+				SetupCombinerProfile(ctx, std::get<ActiveCombiner>(
+					act.GetFrameRecordList().front()));
 			return CombinerReturnThunk(*p_handler, term, ctx);
 		}
 	}
@@ -1488,10 +1645,12 @@ ReduceCombinedBranch(TermNode& term, Context& ctx)
 		term.Tags |= TermTags::Temporary;
 	if(const auto p_handler = TryAccessTerm<ContextHandler>(fm))
 	{
-		yunused(EnsureTCOAction(ctx, term));
-		return
-			CombinerReturnThunk(EnsureTCOAction(ctx, term).Attach(
-				fm.Value).GetObject<ContextHandler>(), term, ctx);
+		auto& h(EnsureTCOAction(ctx, term).Attach(fm.Value)
+			.GetObject<ContextHandler>());
+
+		if(YB_UNLIKELY(bool(ctx.CombinerProfilePtr)))
+			SetupCombinerProfile(ctx, {});
+		return CombinerReturnThunk(h, term, ctx);
 	}
 	assert(IsBranch(term));
 	return ResolveTerm(std::bind(ThrowCombiningFailure, std::ref(term),
@@ -1641,5 +1800,37 @@ TraceBacktrace(const Context::ReducerSequence& backtrace, YSLib::Logger& trace)
 }
 
 
+void
+CombinerProfile::PrintReport(std::ostream& os) const
+{
+	using entry_ref = lref<const pair<const string, Entry>>;
+	vector<entry_ref> refs;
+
+	for(const auto& pr : Entries)
+		if(pr.second.Calls != 0)
+			refs.push_back(pr);
+	std::stable_sort(refs.begin(), refs.end(),
+		[](entry_ref x, entry_ref y) noexcept{
+		return x.get().second.Time > y.get().second.Time;
+	});
+	for(const auto& ref : refs)
+	{
+		const auto& pr(ref.get());
+
+		os << pr.first.c_str() << ": " << pr.second.Calls << " call(s), "
+			<< std::chrono::duration<double, std::milli>(
+			pr.second.Time).count() << " ms\n";
+	}
+	os.flush();
+}
+
+void
+CombinerProfile::Reset() noexcept
+{
+	for(auto& pr : Entries)
+		pr.second = Entry();
+}
+
+
 } // namespace Unilang;
 
@@ -12,9 +12,11 @@
 #include <exception> // for std::throw_with_nested;
 #include "Evaluation.h" // for IsIgnore, RetainN, BindParameterWellFormed,
 //	Unilang::MakeForm, CheckVariadicArity, Form, RetainList,
-//	ReduceForCombinerRef, Strict, Unilang::NameTypedContextHandler;
+//	ReduceForCombinerRef, Strict, Unilang::NameTypedContextHandler,
+//	SetSharedContent, ExpandSharedCode, ReduceOrdered, ReduceOnceLifted,
+//	ReduceReturnUnspecified;
 #include "TermNode.h" // for TNIter, IsTypedRegular, Unilang::AsTermNode,
-//	CountPrefix, TNCIter;
+//	CountPrefix, TNCIter, IsSingleElementList;
 #include <ystdex/algorithm.hpp> // for ystdex::fast_all_of;
 #include <ystdex/range.hpp> // for ystdex::cbegin, ystdex::cend;
 #include <ystdex/utility.hpp> // ystdex::exchange, ystdex::as_const;
@@ -194,7 +196,10 @@ template<typename... _tParams>
 inline void
 AssignParent(Context& ctx, _tParams&&... args)
 {
-	AssignParent(ctx.GetRecordRef().Parent, yforward(args)...);
+	auto& env(ctx.GetRecordRef());
+
+	AssignParent(env.Parent, yforward(args)...);
+	env.NotifyModified();
 }
 
 
@@ -313,19 +318,21 @@ VauBindOne(Context& ctx, const TermNode& formals, TermNode& term)
 
 void
 VauPrepareCall(Context& ctx, TermNode& term, ValueObject& parent,
-	TermNode& eval_struct, bool move)
+	const shared_ptr<TermNode>& p_eval_struct, bool move)
 {
 	AssertNextTerm(ctx, term);
 	if(move)
 	{
 		AssignParent(ctx, std::move(parent));
-		term.SetContent(std::move(eval_struct));
+		term.SetContent(std::move(Unilang::Deref(p_eval_struct)));
 		RefTCOAction(ctx).PopTopFrame();
 	}
 	else
 	{
 		AssignParent(ctx, parent);
-		term.SetContent(eval_struct);
+		// NOTE: The subterms are copied on demand. This also keeps the
+		//	evaluation structure alive during the call.
+		SetSharedContent(term, p_eval_struct);
 	}
 }
 
@@ -401,7 +408,7 @@ public:
 			auto gd(guard_call(*this, term, ctx));
 			const bool no_lift(NoLifting);
 
-			VauPrepareCall(ctx, term, parent, *p_eval_struct, move);
+			VauPrepareCall(ctx, term, parent, p_eval_struct, move);
 			return RelayForCall(ctx, term, std::move(gd), no_lift);
 		}
 		throw UnilangException("Invalid handler of call found.");
@@ -827,6 +834,84 @@ CheckResolvedPairReference(TermNode& nd, bool has_ref)
 		ThrowValueCategoryError(nd);
 }
 
+
+ReductionStatus
+ReduceCondClauses(TermNode& term, Context& ctx)
+{
+	if(term.empty())
+		return ReduceReturnUnspecified(term);
+
+	auto& clause(AccessFirstSubterm(term));
+
+	// NOTE: The clauses may be not expanded, see %SharedCode.
+	ExpandSharedCode(clause);
+	if(IsBranch(clause))
+		return ReduceSubsequent(AccessFirstSubterm(clause), ctx,
+			NameTypedReducerHandler([&]{
+			auto& tm(AccessFirstSubterm(term));
+
+			if(ExtractBool(AccessFirstSubterm(tm)))
+			{
+				RemoveHead(tm);
+				return ReduceOnceLifted(term, ctx, tm);
+			}
+			RemoveHead(term);
+			return ReduceCondClauses(term, ctx);
+		}, "select-clause"));
+	throw InvalidSyntax("Syntax error in conditional clause.");
+}
+
+ReductionStatus
+ReduceConditionalSequence(TermNode& term, Context& ctx, bool is_when)
+{
+	RetainList(term);
+	if(term.size() > 1)
+	{
+		RemoveHead(term);
+		return ReduceSubsequent(AccessFirstSubterm(term), ctx,
+			NameTypedReducerHandler([&, is_when]{
+			if(ExtractBool(AccessFirstSubterm(term)) == is_when)
+			{
+				RemoveHead(term);
+				return ReduceOrdered(term, ctx);
+			}
+			return ReduceReturnUnspecified(term);
+		}, "select-clause"));
+	}
+	throw InvalidSyntax("Syntax error in conditional form.");
+}
+
+// NOTE: The operands are reduced in order until the result is determined. The
+//	last operand is reduced as the result in the tail context.
+ReductionStatus
+ReduceLogicalOperands(TermNode& term, Context& ctx, bool is_or)
+{
+	if(term.empty())
+	{
+		term.SetValue(!is_or);
+		return ReductionStatus::Clean;
+	}
+	if(IsSingleElementList(term))
+		return ReduceOnceLifted(term, ctx, AccessFirstSubterm(term));
+	return ReduceSubsequent(AccessFirstSubterm(term), ctx,
+		NameTypedReducerHandler([&, is_or]{
+		auto& tm(AccessFirstSubterm(term));
+
+		if(ExtractBool(tm) != is_or)
+		{
+			RemoveHead(term);
+			return ReduceLogicalOperands(term, ctx, is_or);
+		}
+		if(is_or)
+		{
+			LiftOther(term, tm);
+			return ReductionStatus::Retained;
+		}
+		term.SetValue(false);
+		return ReductionStatus::Clean;
+	}, "eval-logical-operand"));
+}
+
 } // unnamed namespace;
 
 bool
@@ -957,6 +1042,42 @@ If(TermNode& term, Context& ctx)
 		throw InvalidSyntax("Syntax error in conditional form.");
 }
 
+ReductionStatus
+Cond(TermNode& term, Context& ctx)
+{
+	RetainList(term);
+	RemoveHead(term);
+	return ReduceCondClauses(term, ctx);
+}
+
+ReductionStatus
+When(TermNode& term, Context& ctx)
+{
+	return ReduceConditionalSequence(term, ctx, true);
+}
+
+ReductionStatus
+Unless(TermNode& term, Context& ctx)
+{
+	return ReduceConditionalSequence(term, ctx, {});
+}
+
+ReductionStatus
+And(TermNode& term, Context& ctx)
+{
+	RetainList(term);
+	RemoveHead(term);
+	return ReduceLogicalOperands(term, ctx, {});
+}
+
+ReductionStatus
+Or(TermNode& term, Context& ctx)
+{
+	RetainList(term);
+	RemoveHead(term);
+	return ReduceLogicalOperands(term, ctx, true);
+}
+
 
 ReductionStatus
 Cons(TermNode& term)
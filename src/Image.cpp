@@ -0,0 +1,624 @@
+﻿// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co.,Ltd.
+
+#include "Image.h" // for string, string_view, TermNode, GlobalState,
+//	ValueObject, TokenValue, TermTags, vector, shared_ptr, in_place_type,
+//	type_id, sfmt;
+#include "Evaluation.h" // for ValueToken, QuerySourceInformation,
+//	SetSourcedToken, SetSourcedString;
+#include <climits> // for CHAR_BIT;
+#include <cstring> // for std::memcpy;
+#include <fstream> // for std::ifstream, std::ofstream;
+#include <iterator> // for std::istreambuf_iterator;
+#include <chrono> // for std::chrono::steady_clock;
+#include <cstdio> // for std::rename, std::remove;
+#include <stdexcept> // for std::out_of_range;
+#include <sys/stat.h> // for struct ::stat, ::stat;
+#include <cstdint> // for std::uint_least64_t;
+
+namespace Unilang
+{
+
+namespace
+{
+
+// NOTE: The magic shall be changed once the format is changed.
+const char ImageMagic[]{"UnilangTermImage1"};
+// NOTE: The images depend on the preprocessing and the layout of the values in
+//	the build. The build identifier is configured by the build scripts (see
+//	build.sh) to identify the source revision. It is not derived from the
+//	time of the build, so the builds are reproducible.
+#ifndef Unilang_BuildId
+#	define Unilang_BuildId "unconfigured"
+#endif
+
+YB_ATTR_nodiscard const string&
+GetImageBuild()
+{
+	static const string build([]{
+		const unsigned x(1);
+
+		// XXX: The numbers are stored in the native representation, see
+		//	%NumberImage.
+		return sfmt("%s:%c:%zu:%zu:%zu:%zu", Unilang_BuildId,
+			*reinterpret_cast<const unsigned char*>(&x) == 1 ? 'l' : 'b',
+			sizeof(long), sizeof(long long), sizeof(long double),
+			sizeof(void*));
+	}());
+
+	return build;
+}
+
+enum class ValueTag : unsigned char
+{
+	Empty,
+	Token,
+	String,
+	SourcedToken,
+	SourcedString,
+	Bool,
+	Unit,
+	Prefix,
+	Number
+};
+
+
+void
+WriteSize(string& buf, size_t n)
+{
+	while(n >= 0x80)
+	{
+		buf += char((n & 0x7F) | 0x80);
+		n >>= 7;
+	}
+	buf += char(n);
+}
+
+YB_ATTR_nodiscard bool
+ReadSize(string_view& sv, size_t& n)
+{
+	n = 0;
+	for(size_t shift(0); !sv.empty() && shift < sizeof(size_t) * CHAR_BIT;
+		shift += 7)
+	{
+		const auto c(static_cast<unsigned char>(sv.front()));
+
+		sv.remove_prefix(1);
+		n |= size_t(c & 0x7F) << shift;
+		if(c < 0x80)
+			return true;
+	}
+	return {};
+}
+
+void
+WriteString(string& buf, string_view str)
+{
+	WriteSize(buf, str.size());
+	buf.append(str.data(), str.size());
+}
+
+YB_ATTR_nodiscard bool
+ReadString(string_view& sv, string_view& str)
+{
+	size_t n;
+
+	if(ReadSize(sv, n) && n <= sv.size())
+	{
+		str = sv.substr(0, n);
+		sv.remove_prefix(n);
+		return true;
+	}
+	return {};
+}
+
+YB_ATTR_nodiscard bool
+ReadTag(string_view& sv, ValueTag& tag)
+{
+	if(!sv.empty())
+	{
+		tag = ValueTag(sv.front());
+		sv.remove_prefix(1);
+		return true;
+	}
+	return {};
+}
+
+
+// NOTE: The numbers are stored in the native representation, which is fixed
+//	by the build.
+template<typename...>
+struct NumberImage
+{
+	static bool
+	Write(string&, const ValueObject&, unsigned char)
+	{
+		return {};
+	}
+
+	static bool
+	Read(string_view&, ValueObject&, unsigned char)
+	{
+		return {};
+	}
+};
+
+template<typename _type, typename... _types>
+struct NumberImage<_type, _types...>
+{
+	static bool
+	Write(string& buf, const ValueObject& vo, unsigned char code = 0)
+	{
+		if(const auto p = vo.AccessPtr<_type>())
+		{
+			buf += char(ValueTag::Number);
+			buf += char(code);
+			buf.append(reinterpret_cast<const char*>(p), sizeof(_type));
+			return true;
+		}
+		return NumberImage<_types...>::Write(buf, vo, code + 1);
+	}
+
+	static bool
+	Read(string_view& sv, ValueObject& vo, unsigned char code)
+	{
+		if(code == 0)
+		{
+			if(sv.size() >= sizeof(_type))
+			{
+				_type x;
+
+				std::memcpy(&x, sv.data(), sizeof(_type));
+				sv.remove_prefix(sizeof(_type));
+				vo = x;
+				return true;
+			}
+			return {};
+		}
+		return NumberImage<_types...>::Read(sv, vo, code - 1);
+	}
+};
+
+// NOTE: The types shall be consistent to the numeric leaves, see %ReadDecimal.
+using NumberImages = NumberImage<int, unsigned, long long, unsigned long long,
+	double, long, unsigned long, short, unsigned short, signed char,
+	unsigned char, float, long double>;
+
+
+class TermImageWriter final
+{
+private:
+	string& buffer;
+	const GlobalState& global;
+	// NOTE: The source names are numbered from 1 in the order of occurrence.
+	vector<const string*> names;
+
+public:
+	TermImageWriter(string& buf, const GlobalState& g)
+		: buffer(buf), global(g), names(g.Allocator)
+	{}
+
+	YB_ATTR_nodiscard bool
+	operator()(const TermNode& term)
+	{
+		WriteSize(buffer, size_t(term.Tags));
+		if(WriteValue(term.Value))
+		{
+			WriteSize(buffer, term.size());
+			for(const auto& sub : term)
+				if(!(*this)(sub))
+					return {};
+			return true;
+		}
+		return {};
+	}
+
+private:
+	void
+	WriteName(const string* p_name)
+	{
+		if(p_name)
+		{
+			for(size_t idx(0); idx != names.size(); ++idx)
+				if(names[idx] == p_name)
+				{
+					WriteSize(buffer, idx + 1);
+					return;
+				}
+			names.push_back(p_name);
+			WriteSize(buffer, names.size());
+			WriteString(buffer, *p_name);
+		}
+		else
+			WriteSize(buffer, 0);
+	}
+
+	YB_ATTR_nodiscard bool
+	WriteValue(const ValueObject& vo)
+	{
+		if(!vo)
+			buffer += char(ValueTag::Empty);
+		else if(const auto p_si = QuerySourceInformation(vo))
+		{
+			const bool is_token(vo.type() == type_id<TokenValue>());
+
+			if(!is_token && vo.type() != type_id<string>())
+				return {};
+			buffer += char(is_token ? ValueTag::SourcedToken
+				: ValueTag::SourcedString);
+			WriteName(p_si->first.get());
+			WriteSize(buffer, p_si->second.Line);
+			WriteSize(buffer, p_si->second.Column);
+			WriteString(buffer, is_token
+				? string_view(vo.GetObject<TokenValue>())
+				: string_view(vo.GetObject<string>()));
+		}
+		else if(const auto p_tok = vo.AccessPtr<TokenValue>())
+		{
+			buffer += char(ValueTag::Token);
+			WriteString(buffer, *p_tok);
+		}
+		else if(const auto p_str = vo.AccessPtr<string>())
+		{
+			buffer += char(ValueTag::String);
+			WriteString(buffer, *p_str);
+		}
+		else if(const auto p_b = vo.AccessPtr<bool>())
+		{
+			buffer += char(ValueTag::Bool);
+			buffer += char(*p_b);
+		}
+		else if(const auto p_vt = vo.AccessPtr<ValueToken>())
+		{
+			buffer += char(ValueTag::Unit);
+			WriteSize(buffer, size_t(*p_vt));
+		}
+		else if(!NumberImages::Write(buffer, vo))
+		{
+			const auto idx(global.Preprocess.FindPrefix(vo));
+
+			if(idx == size_t(-1))
+				return {};
+			buffer += char(ValueTag::Prefix);
+			WriteSize(buffer, idx);
+		}
+		return true;
+	}
+};
+
+
+class TermImageReader final
+{
+private:
+	string_view& image;
+	const GlobalState& global;
+	vector<shared_ptr<string>> names;
+
+public:
+	TermImageReader(string_view& sv, const GlobalState& g)
+		: image(sv), global(g), names(g.Allocator)
+	{}
+
+	YB_ATTR_nodiscard bool
+	operator()(TermNode& term)
+	{
+		size_t tags, n;
+
+		if(ReadSize(image, tags) && ReadValue(term) && ReadSize(image, n))
+		{
+			term.Tags = TermTags(tags);
+			for(; n != 0; --n)
+			{
+				TermNode sub(global.Allocator);
+
+				if(!(*this)(sub))
+					return {};
+				term.Add(std::move(sub));
+			}
+			return true;
+		}
+		return {};
+	}
+
+private:
+	YB_ATTR_nodiscard bool
+	ReadName(shared_ptr<string>& name)
+	{
+		size_t idx;
+
+		if(ReadSize(image, idx))
+		{
+			if(idx == 0)
+				name = {};
+			else if(idx <= names.size())
+				name = names[idx - 1];
+			else if(idx == names.size() + 1)
+			{
+				string_view str;
+
+				if(!ReadString(image, str))
+					return {};
+				name = YSLib::allocate_shared<string>(
+					string::allocator_type(global.Allocator), str.data(),
+					str.size());
+				names.push_back(name);
+			}
+			else
+				return {};
+			return true;
+		}
+		return {};
+	}
+
+	YB_ATTR_nodiscard bool
+	ReadValue(TermNode& term)
+	{
+		ValueTag tag;
+		string_view str;
+		size_t n;
+
+		if(!ReadTag(image, tag))
+			return {};
+		switch(tag)
+		{
+		case ValueTag::Empty:
+			term.Value = ValueObject();
+			return true;
+		case ValueTag::Token:
+			if(ReadString(image, str))
+			{
+				term.SetValue(in_place_type<TokenValue>, str,
+					term.get_allocator());
+				return true;
+			}
+			break;
+		case ValueTag::String:
+			if(ReadString(image, str))
+			{
+				term.SetValue(in_place_type<string>, str,
+					term.get_allocator());
+				return true;
+			}
+			break;
+		case ValueTag::SourcedToken:
+		case ValueTag::SourcedString:
+			{
+				shared_ptr<string> name;
+				size_t line, col;
+
+				if(ReadName(name) && ReadSize(image, line)
+					&& ReadSize(image, col) && ReadString(image, str))
+				{
+					if(tag == ValueTag::SourcedToken)
+						SetSourcedToken(term, str, name, {line, col});
+					else
+						SetSourcedString(term, str, name, {line, col});
+					return true;
+				}
+			}
+			break;
+		case ValueTag::Bool:
+			if(!image.empty())
+			{
+				term.Value = image.front() != char();
+				image.remove_prefix(1);
+				return true;
+			}
+			break;
+		case ValueTag::Unit:
+			if(ReadSize(image, n) && n <= size_t(ValueToken::Ignore))
+			{
+				term.Value = ValueToken(n);
+				return true;
+			}
+			break;
+		case ValueTag::Prefix:
+			if(ReadSize(image, n))
+				try
+				{
+					term.Value = global.Preprocess.GetPrefix(n);
+					return bool(term.Value);
+				}
+				catch(std::out_of_range&)
+				{}
+			break;
+		case ValueTag::Number:
+			if(!image.empty())
+			{
+				const auto code(static_cast<unsigned char>(image.front()));
+
+				image.remove_prefix(1);
+				return NumberImages::Read(image, term.Value, code);
+			}
+		}
+		return {};
+	}
+};
+
+} // unnamed namespace;
+
+bool
+WriteTermImage(string& buf, const TermNode& term, const GlobalState& global)
+{
+	return TermImageWriter(buf, global)(term);
+}
+
+bool
+ReadTermImage(string_view& sv, TermNode& term, const GlobalState& global)
+{
+	return TermImageReader(sv, global)(term);
+}
+
+
+bool
+TermImageFile::Load(const string& path)
+{
+	Records.clear();
+
+	std::ifstream ifs(path.c_str(), std::ios_base::binary);
+
+	if(ifs)
+	{
+		const std::string data{std::istreambuf_iterator<char>(ifs),
+			std::istreambuf_iterator<char>()};
+		string_view sv(data.data(), data.size()), magic, build;
+		size_t n;
+
+		if(ReadString(sv, magic) && magic == ImageMagic
+			&& ReadString(sv, build) && build == GetImageBuild()
+			&& ReadSize(sv, n))
+		{
+			for(; n != 0; --n)
+			{
+				string_view key, rec;
+
+				if(!(ReadString(sv, key) && ReadString(sv, rec)))
+					break;
+				Records.emplace(string(key.data(), key.size()),
+					string(rec.data(), rec.size()));
+			}
+			if(n == 0 && sv.empty())
+				return true;
+		}
+		Records.clear();
+	}
+	return {};
+}
+
+bool
+TermImageFile::Save(const string& path) const
+{
+	string buf;
+
+	WriteString(buf, ImageMagic);
+	WriteString(buf, GetImageBuild());
+	WriteSize(buf, Records.size());
+	for(const auto& pr : Records)
+	{
+		WriteString(buf, pr.first);
+		WriteString(buf, pr.second);
+	}
+
+	// NOTE: The temporary file name is unique among the processes saving the
+	//	same file concurrently in practice.
+	const auto tmp(path + sfmt(".%llx.%p.tmp", static_cast<unsigned long long>(
+		std::chrono::steady_clock::now().time_since_epoch().count()),
+		static_cast<const void*>(&buf)));
+
+	{
+		std::ofstream ofs(tmp.c_str(), std::ios_base::binary);
+
+		if(!(ofs && ofs.write(buf.data(), std::streamsize(buf.size()))
+			&& ofs.flush()))
+		{
+			ofs.close();
+			std::remove(tmp.c_str());
+			return {};
+		}
+	}
+	if(std::rename(tmp.c_str(), path.c_str()) != 0)
+	{
+		// XXX: The existing file is not replaced by %std::rename on some
+		//	platforms, e.g. Win32.
+		std::remove(path.c_str());
+		if(std::rename(tmp.c_str(), path.c_str()) != 0)
+		{
+			std::remove(tmp.c_str());
+			return {};
+		}
+	}
+	return true;
+}
+
+
+string
+MakeFileImageKey(const string& path, bool sourced)
+{
+	struct ::stat st;
+
+	if(::stat(path.c_str(), &st) == 0)
+	{
+		// NOTE: The nanoseconds of the times are needed to detect the changes
+		//	of the file in the same second with the same size.
+#if YCL_Win32
+		// XXX: The nanoseconds are not available, so such changes are not
+		//	detected.
+		const long mtime_ns(0), ctime_ns(0);
+#elif __APPLE__
+		const long mtime_ns(st.st_mtimespec.tv_nsec),
+			ctime_ns(st.st_ctimespec.tv_nsec);
+#else
+		const long mtime_ns(st.st_mtim.tv_nsec), ctime_ns(st.st_ctim.tv_nsec);
+#endif
+
+		return sfmt("file:%c:%llx:%llx:%llx.%lx:%llx.%lx:%llx:",
+			sourced ? 's' : 'n', static_cast<unsigned long long>(st.st_dev),
+			static_cast<unsigned long long>(st.st_ino),
+			static_cast<unsigned long long>(st.st_mtime), mtime_ns,
+			static_cast<unsigned long long>(st.st_ctime), ctime_ns,
+			static_cast<unsigned long long>(st.st_size)) + path;
+	}
+	return {};
+}
+
+
+FileImageCache::FileImageCache(string dir)
+	: directory(std::move(dir))
+{}
+
+bool
+FileImageCache::Restore(const string& path, const string& key, TermNode& term,
+	const GlobalState& global) const
+{
+	TermImageFile file;
+
+	if(file.Load(GetCacheFileName(path)))
+	{
+		const auto i(file.Records.find(path));
+
+		if(i != file.Records.end())
+		{
+			string_view sv(i->second.data(), i->second.size()), k;
+
+			return ReadString(sv, k) && k == key
+				&& ReadTermImage(sv, term, global) && sv.empty();
+		}
+	}
+	return {};
+}
+
+void
+FileImageCache::Record(const string& path, const string& key,
+	const TermNode& term, const GlobalState& global) const
+{
+	string buf;
+
+	WriteString(buf, key);
+	if(WriteTermImage(buf, term, global))
+	{
+		TermImageFile file;
+		const auto name(GetCacheFileName(path));
+
+		// NOTE: The records of other source files with the same hash of the
+		//	paths are kept. They can still be dropped by the concurrent
+		//	recording in other processes, which only causes the cache misses.
+		file.Load(name);
+		file.Records[path] = std::move(buf);
+		file.Save(name);
+	}
+}
+
+string
+FileImageCache::GetCacheFileName(const string& path) const
+{
+	// NOTE: This is the 64-bit FNV-1a hash.
+	std::uint_least64_t h(0xCBF29CE484222325ULL);
+
+	for(const char c : path)
+		h = ((h ^ static_cast<unsigned char>(c)) * 0x100000001B3ULL)
+			& 0xFFFFFFFFFFFFFFFFULL;
+	return directory + sfmt("/%016llx.uimg", static_cast<unsigned long long>(
+		h));
+}
+
+} // namespace Unilang;
+
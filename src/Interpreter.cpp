@@ -4,16 +4,28 @@
 //	string_view, Context::DefaultHandleException, std::bind, std::getline;
 #include <ostream> // for std::ostream;
 #include "Math.h" // for FPToString;
-#include <ystdex/functional.hpp> // for ystdex::bind1, std::placeholders::_1;
+#include <ystdex/functional.hpp> // for ystdex::bind1, std::placeholders::_1,
+//	ystdex::equal_to;
 #include "Evaluation.h" // for TraceBacktrace;
 #include <YSLib/Service/YModules.h>
 #include YFM_YSLib_Core_YException // for YSLib, YSLib::ExtractException,
-//	YSLib::Notice, YSLib::stringstream;
+//	YSLib::Notice, YSLib::unordered_map, type_index, type_id;
 #include YFM_YSLib_Service_TextFile // for Text::OpenSkippedBOMtream,
 //	Text::BOM_UTF_8, YSLib::share_move;
+#include YFM_YCLib_MemoryMapping // for platform::MappedFile;
 #include <exception> // for std::throw_with_nested;
 #include <ystdex/scope_guard.hpp> // for ystdex::make_guard;
-#include <iostream> // for std::cout, std::endl, std::cin;
+#include <iostream> // for std::cout, std::endl, std::cin, std::clog;
+#include "Exception.h" // for UnilangException;
+#include "TCO.h" // for TCOAction, ActiveCombiner;
+#include <fstream> // for std::ofstream;
+#include <functional> // for std::hash;
+#include <memory> // for std::allocator;
+#include <limits> // for std::numeric_limits;
+#include <cstdio> // for std::snprintf;
+#include <type_traits> // for std::is_signed;
+#include <cstring> // for std::memcpy;
+#include "Image.h" // for FileImageCache, MakeFileImageKey;
 
 namespace Unilang
 {
@@ -29,91 +41,110 @@ PrintTermNode(std::ostream& os, const TermNode& term, _func f, size_t depth = 0,
 	if(depth != 0 && idx != 0)
 		os << ' ';
 	ResolveTerm([&](const TermNode& tm){
-		try
-		{
-			f(os, tm);
-			return;
-		}
-		catch(bad_any_cast&)
-		{}
-		os << '(';
-		try
+		if(!f(os, tm))
 		{
 			size_t i(0);
 
+			os << '(';
 			for(const auto& nd : tm)
 			{
 				PrintTermNode(os, nd, f, depth + 1, i);
 				++i;
 			}
+			os << ')';
 		}
-		catch(std::out_of_range&)
-		{}
-		os << ')';
 	}, term);
 }
 
-YB_ATTR_nodiscard YB_PURE string
-StringifyValueObject(const ValueObject& vo)
-{
-	if(const auto p = vo.AccessPtr<string>())
-		return ystdex::quote(*p);
-	if(const auto p = vo.AccessPtr<TokenValue>())
-		return *p;
-	if(const auto p = vo.AccessPtr<bool>())
-		return *p ? "#t" : "#f";
-	if(const auto p = vo.AccessPtr<int>())
-		return sfmt<string>("%d", *p);
-	if(const auto p = vo.AccessPtr<unsigned>())
-		return sfmt<string>("%u", *p);
-	if(const auto p = vo.AccessPtr<long long>())
-		return sfmt<string>("%lld", *p);
-	if(const auto p = vo.AccessPtr<unsigned long long>())
-		return sfmt<string>("%llu", *p);
-	if(const auto p = vo.AccessPtr<double>())
-		return FPToString(*p);
-	if(const auto p = vo.AccessPtr<long>())
-		return sfmt<string>("%ld", *p);
-	if(const auto p = vo.AccessPtr<unsigned long>())
-		return sfmt<string>("%lu", *p);
-	if(const auto p = vo.AccessPtr<short>())
-		return sfmt<string>("%hd", *p);
-	if(const auto p = vo.AccessPtr<unsigned short>())
-		return sfmt<string>("%hu", *p);
-	if(const auto p = vo.AccessPtr<signed char>())
-		return sfmt<string>("%d", int(*p));
-	if(const auto p = vo.AccessPtr<unsigned char>())
-		return sfmt<string>("%u", unsigned(*p));
-	if(const auto p = vo.AccessPtr<float>())
-		return FPToString(*p);
-	if(const auto p = vo.AccessPtr<long double>())
-		return FPToString(*p);
-	if(const auto p = vo.AccessPtr<int>())
-		return ystdex::sfmt<string>("%d", *p);
-	if(const auto p = vo.AccessPtr<ValueToken>())
-		if(*p == ValueToken::Unspecified)
-			return "#inert";
+// NOTE: The boolean parameter specifies whether the strings are quoted.
+using ValuePrinter = void(*)(std::ostream&, const ValueObject&, bool);
+using PrinterTable = YSLib::unordered_map<type_index, ValuePrinter,
+	std::hash<type_index>, ystdex::equal_to<type_index>,
+	std::allocator<std::pair<const type_index, ValuePrinter>>>;
 
-	const auto& t(vo.type());
+template<typename _type>
+void
+PrintIntegerValue(std::ostream& os, const ValueObject& vo, bool)
+{
+	// NOTE: The value is formatted in a fixed buffer, so the result does not
+	//	depend on the flags and the locale of the stream.
+	char buf[std::numeric_limits<unsigned long long>::digits10 + 3];
+	const auto x(vo.GetObject<_type>());
+	const int n(std::is_signed<_type>() ? std::snprintf(buf, sizeof(buf),
+		"%lld", static_cast<long long>(x)) : std::snprintf(buf, sizeof(buf),
+		"%llu", static_cast<unsigned long long>(x)));
+
+	os.write(buf, std::streamsize(n));
+}
 
-	if(t != typeid(void))
-		return "#[" + string(t.name()) + ']';
-	throw bad_any_cast();
+template<typename _type>
+void
+PrintFloatingValue(std::ostream& os, const ValueObject& vo, bool)
+{
+	os << FPToString(vo.GetObject<_type>()).c_str();
 }
 
-YB_ATTR_nodiscard YB_PURE string
-StringifyValueObjectForDisplay(const ValueObject& vo)
+YB_ATTR_nodiscard PrinterTable
+MakePrinterTable()
 {
-	if(const auto p = vo.AccessPtr<string>())
-		return *p;
-	return StringifyValueObject(vo);
+	PrinterTable tbl{{type_id<string>(),
+		[](std::ostream& os, const ValueObject& vo, bool quoted){
+		const auto& str(vo.GetObject<string>());
+
+		if(quoted)
+			os << '"';
+		os.write(str.data(), std::streamsize(str.size()));
+		if(quoted)
+			os << '"';
+	}}, {type_id<TokenValue>(),
+		[](std::ostream& os, const ValueObject& vo, bool){
+		const auto& str(vo.GetObject<TokenValue>());
+
+		os.write(str.data(), std::streamsize(str.size()));
+	}}, {type_id<bool>(), [](std::ostream& os, const ValueObject& vo, bool){
+		os << (vo.GetObject<bool>() ? "#t" : "#f");
+	}}, {type_id<ValueToken>(),
+		[](std::ostream& os, const ValueObject& vo, bool){
+		if(vo.GetObject<ValueToken>() == ValueToken::Unspecified)
+			os << "#inert";
+		else
+			os << "#[" << vo.type().name() << ']';
+	}}};
+
+	tbl.emplace(type_id<int>(), PrintIntegerValue<int>);
+	tbl.emplace(type_id<unsigned>(), PrintIntegerValue<unsigned>);
+	tbl.emplace(type_id<long long>(), PrintIntegerValue<long long>);
+	tbl.emplace(type_id<unsigned long long>(),
+		PrintIntegerValue<unsigned long long>);
+	tbl.emplace(type_id<long>(), PrintIntegerValue<long>);
+	tbl.emplace(type_id<unsigned long>(), PrintIntegerValue<unsigned long>);
+	tbl.emplace(type_id<short>(), PrintIntegerValue<short>);
+	tbl.emplace(type_id<unsigned short>(), PrintIntegerValue<unsigned short>);
+	tbl.emplace(type_id<signed char>(), PrintIntegerValue<signed char>);
+	tbl.emplace(type_id<unsigned char>(), PrintIntegerValue<unsigned char>);
+	tbl.emplace(type_id<double>(), PrintFloatingValue<double>);
+	tbl.emplace(type_id<float>(), PrintFloatingValue<float>);
+	tbl.emplace(type_id<long double>(), PrintFloatingValue<long double>);
+	return tbl;
 }
 
-YB_ATTR_nodiscard YB_PURE string
-StringifyValueObjectForWrite(const ValueObject& vo)
+// NOTE: The result is whether the value is not empty and printed.
+bool
+PrintValueObject(std::ostream& os, const ValueObject& vo, bool quoted = true)
 {
-	// XXX: At current, this is just same to the "print" routine.
-	return StringifyValueObject(vo);
+	// NOTE: The table is immutable after the initialization, so no lock is
+	//	needed for the lookup.
+	static const auto tbl(MakePrinterTable());
+	const auto& t(vo.type());
+	const auto i(tbl.find(type_index(t)));
+
+	if(i != tbl.cend())
+		i->second(os, vo, quoted);
+	else if(t != typeid(void))
+		os << "#[" << t.name() << ']';
+	else
+		return {};
+	return true;
 }
 
 YB_ATTR_nodiscard YB_PURE std::string
@@ -180,12 +211,280 @@ OpenFile(const char* filename)
 	}
 }
 
+YSLib::unique_ptr<platform::MappedFile>
+MapFile(const char* filename)
+{
+	try
+	{
+		return YSLib::make_unique<platform::MappedFile>(filename);
+	}
+	catch(...)
+	{
+		std::throw_with_nested(std::invalid_argument(
+			ystdex::sfmt("Failed opening file '%s'.", filename)));
+	}
+}
+
+// NOTE: The BOM is skipped as %OpenFile.
+YB_ATTR_nodiscard YB_PURE string_view
+ViewMappedFile(const platform::MappedFile& f) noexcept
+{
+	const string_view
+		res(reinterpret_cast<const char*>(f.GetPtr()), f.GetSize()),
+		bom(YSLib::Text::BOM_UTF_8);
+
+	return res.substr(0, bom.size()) == bom ? res.substr(bom.size()) : res;
+}
+
+YB_ATTR_nodiscard MemoryResourceKind
+FetchEnvironmentMemoryResourceKind()
+{
+	if(const auto str = std::getenv("UNILANG_MEMORY_RESOURCE"))
+		return ParseMemoryResourceKind(str);
+	return MemoryResourceKind::Default;
+}
+
+YB_ATTR_nodiscard YSLib::unique_ptr<pmr::memory_resource>
+MakeMemoryResource(MemoryResourceKind kind)
+{
+	using YSLib::make_unique;
+	const auto p_upstream(pmr::new_delete_resource());
+
+	switch(kind)
+	{
+	case MemoryResourceKind::Pool:
+		return make_unique<pmr::unsynchronized_pool_resource>(p_upstream);
+	case MemoryResourceKind::SynchronizedPool:
+		return make_unique<pmr::synchronized_pool_resource>(p_upstream);
+	case MemoryResourceKind::Monotonic:
+		return make_unique<pmr::monotonic_buffer_resource>(p_upstream);
+	case MemoryResourceKind::Tracking:
+		return make_unique<TrackingResource>(Unilang::Deref(p_upstream));
+	default:
+		return {};
+	}
+}
+
+YB_ATTR_nodiscard size_t
+FetchEnvironmentProfilePeriod()
+{
+	if(const auto str = std::getenv("UNILANG_PROFILE_PERIOD"))
+	{
+		const auto n(std::strtoul(str, {}, 10));
+
+		if(n != 0)
+			return size_t(n);
+	}
+	return 1000;
+}
+
+// NOTE: The phase is stored just before the block returned to the user. The
+//	alignment is a power of 2, so the offset is a multiple of it.
+YB_ATTR_nodiscard YB_STATELESS constexpr size_t
+GetTrackingHeaderSize(size_t alignment) noexcept
+{
+	return alignment < sizeof(AllocationPhase) ? sizeof(AllocationPhase)
+		: alignment;
+}
+
+YB_ATTR_nodiscard YB_STATELESS constexpr size_t
+GetTrackingAlignment(size_t alignment) noexcept
+{
+	return alignment < alignof(AllocationPhase) ? alignof(AllocationPhase)
+		: alignment;
+}
+
 } // unnamed namespace;
 
 
+MemoryResourceKind
+ParseMemoryResourceKind(string_view str)
+{
+	if(str.empty() || str == "default")
+		return MemoryResourceKind::Default;
+	if(str == "pool")
+		return MemoryResourceKind::Pool;
+	if(str == "sync-pool")
+		return MemoryResourceKind::SynchronizedPool;
+	if(str == "monotonic")
+		return MemoryResourceKind::Monotonic;
+	if(str == "tracking")
+		return MemoryResourceKind::Tracking;
+	throw UnilangException(ystdex::sfmt("Invalid memory resource kind '%s'"
+		" found.", string(str).c_str()));
+}
+
+
+void
+TrackingResource::PrintStatistics(std::ostream& os) const
+{
+	static yconstexpr const char* const
+		names[AllocationPhaseCount]{"other", "parse", "preprocess",
+		"reduction", "environment"};
+
+	os << "Allocations: " << AllocationCount << ", deallocations: "
+		<< DeallocationCount << ", allocated bytes: " << AllocatedBytes
+		<< ", current bytes: " << CurrentBytes << ", peak bytes: " << PeakBytes
+		<< '.' << std::endl;
+	for(size_t i(0); i != AllocationPhaseCount; ++i)
+	{
+		const auto& st(Phases[i]);
+
+		if(st.AllocationCount != 0 || st.DeallocationCount != 0)
+			os << "Phase " << names[i] << ": allocations: "
+				<< st.AllocationCount << ", deallocations: "
+				<< st.DeallocationCount << ", allocated bytes: "
+				<< st.AllocatedBytes << ", deallocated bytes: "
+				<< st.DeallocatedBytes << ", peak bytes: " << st.PeakBytes
+				<< '.' << std::endl;
+	}
+}
+
+void*
+TrackingResource::do_allocate(size_t bytes, size_t alignment)
+{
+	const auto offset(GetTrackingHeaderSize(alignment));
+	const auto phase(FetchAllocationPhaseRef());
+	const auto p(static_cast<byte*>(upstream.get().allocate(bytes + offset,
+		GetTrackingAlignment(alignment))) + offset);
+	auto& st(Phases[size_t(phase)]);
+
+	std::memcpy(p - sizeof(AllocationPhase), &phase, sizeof(AllocationPhase));
+
+	++AllocationCount;
+	AllocatedBytes += bytes;
+	CurrentBytes += bytes;
+	if(PeakBytes < CurrentBytes)
+		PeakBytes = CurrentBytes;
+	++st.AllocationCount;
+	st.AllocatedBytes += bytes;
+	if(st.PeakBytes < CurrentBytes)
+		st.PeakBytes = CurrentBytes;
+	return p;
+}
+
+void
+TrackingResource::do_deallocate(void* p, size_t bytes, size_t alignment)
+{
+	const auto offset(GetTrackingHeaderSize(alignment));
+	const auto p_block(static_cast<byte*>(p) - offset);
+	AllocationPhase phase;
+
+	std::memcpy(&phase, static_cast<byte*>(p) - sizeof(AllocationPhase),
+		sizeof(AllocationPhase));
+
+	auto& st(Phases[size_t(phase)]);
+
+	upstream.get().deallocate(p_block, bytes + offset,
+		GetTrackingAlignment(alignment));
+	++DeallocationCount;
+	CurrentBytes -= bytes;
+	++st.DeallocationCount;
+	st.DeallocatedBytes += bytes;
+}
+
+bool
+TrackingResource::do_is_equal(const pmr::memory_resource& other) const noexcept
+{
+	return this == &other;
+}
+
+
+void
+SamplingProfiler::operator()(const Context& ctx)
+{
+	if(--countdown == 0)
+	{
+		countdown = Period;
+		Sample(ctx);
+	}
+}
+
+void
+SamplingProfiler::PrintFolded(std::ostream& os) const
+{
+	for(const auto& pr : samples)
+		os << pr.first.c_str() << ' ' << pr.second << '\n';
+	os.flush();
+}
+
+void
+SamplingProfiler::Sample(const Context& ctx)
+{
+	// NOTE: Both the actions and the frame records are from the innermost one,
+	//	as %TraceBacktrace.
+	frames.clear();
+	for(const auto& act : ctx.GetCurrent())
+		if(const auto p_act = act.target<TCOAction>())
+			for(const auto& r : p_act->GetFrameRecordList())
+			{
+				const auto& op(std::get<ActiveCombiner>(r));
+
+				if(const auto p = op.AccessPtr<TokenValue>())
+				{
+					if(const auto p_si = QuerySourceInformation(op))
+						frames.push_back(sfmt<string>("%s (%s:%zu)",
+							p->c_str(), p_si->first ? p_si->first->c_str()
+							: "<unknown>", p_si->second.Line + 1));
+					else
+						frames.push_back(*p);
+				}
+				else
+					frames.push_back("#[combiner]");
+			}
+
+	string key;
+
+	for(auto i(frames.crbegin()); i != frames.crend(); ++i)
+	{
+		if(!key.empty())
+			key += ';';
+		key += *i;
+	}
+	++samples[key.empty() ? string("#[top-level]") : std::move(key)];
+}
+
+
 Interpreter::Interpreter()
+	: Interpreter(FetchEnvironmentMemoryResourceKind())
+{}
+Interpreter::Interpreter(MemoryResourceKind kind)
+	: p_resource(MakeMemoryResource(kind))
 {
 	Global.UseSourceLocation = UseSourceLocation;
+	if(std::getenv("UNILANG_PROFILE"))
+	{
+		p_profiler.reset(
+			new SamplingProfiler(FetchEnvironmentProfilePeriod()));
+		Main.TraceTail = std::ref(*p_profiler);
+	}
+	if(const auto str = std::getenv("UNILANG_CACHE"))
+		if(*str != char())
+			p_cache.reset(new FileImageCache(str));
+}
+Interpreter::~Interpreter()
+{
+	if(const auto p
+		= dynamic_cast<const TrackingResource*>(p_resource.get()))
+	{
+		std::clog << "Memory resource statistics before the interpreter is"
+			" destroyed:" << std::endl;
+		p->PrintStatistics(std::clog);
+	}
+	if(p_profiler)
+	{
+		const auto str(std::getenv("UNILANG_PROFILE"));
+
+		Main.TraceTail = {};
+		if(str && *str != char())
+		{
+			std::ofstream ofs(str);
+
+			p_profiler->PrintFolded(ofs);
+		}
+		else
+			p_profiler->PrintFolded(std::clog);
+	}
 }
 
 void
@@ -195,6 +494,18 @@ Interpreter::Evaluate(TermNode& term)
 	Main.RewriteTermGuarded(term);
 }
 
+ReductionStatus
+Interpreter::ExecuteForms(FormReader& reader, Context& ctx)
+{
+	if(reader.Read(Term))
+	{
+		RelaySwitched(ctx, std::bind(&Interpreter::ExecuteForms,
+			std::ref(*this), std::ref(reader), std::placeholders::_1));
+		return ExecuteOnce(ctx);
+	}
+	return ReductionStatus::Neutral;
+}
+
 ReductionStatus
 Interpreter::ExecuteOnce(Context& ctx)
 {
@@ -289,6 +600,40 @@ Interpreter::Read(string_view unit)
 	return Global.Read(unit, Main);
 }
 
+TermNode
+Interpreter::ReadFile(Context& ctx, string filename)
+{
+	// NOTE: The lexemes are sliced from the mapping. It is not needed after
+	//	the read, since the leaves own their values.
+	const auto p_mapped(MapFile(filename.c_str()));
+
+	ctx.CurrentSource = YSLib::share_move(filename);
+	return Global.Read(ViewMappedFile(*p_mapped), ctx);
+}
+
+TermNode
+Interpreter::ReadFilePreprocessed(Context& ctx, string filename)
+{
+	const auto key(p_cache ? MakeFileImageKey(filename, UseSourceLocation)
+		: string());
+	TermNode term(Global.Allocator);
+
+	if(key.empty())
+	{
+		term = ReadFile(ctx, std::move(filename));
+		Global.Preprocess(term);
+	}
+	else if(p_cache->Restore(filename, key, term, Global))
+		ctx.CurrentSource = YSLib::share_move(filename);
+	else
+	{
+		term = ReadFile(ctx, filename);
+		Global.Preprocess(term);
+		p_cache->Record(filename, key, term, Global);
+	}
+	return term;
+}
+
 void
 Interpreter::Run()
 {
@@ -311,11 +656,27 @@ Interpreter::RunLine(string_view unit)
 void
 Interpreter::RunScript(string filename)
 {
+	// NOTE: The stream and the reader are used by the continuations until
+	//	%Context::Rewrite returns.
+	YSLib::unique_ptr<std::istream> p_is;
+	YSLib::unique_ptr<FormReader> p_reader;
+	const auto run_stream([&](std::istream& is, Context& ctx)
+		-> ReductionStatus{
+		if(const auto p = is.rdbuf())
+		{
+			p_reader.reset(new FormReader(Global, *p, Main));
+			return ExecuteForms(*p_reader, ctx);
+		}
+		throw std::invalid_argument("Invalid stream buffer found.");
+	});
+
 	if(filename == "-")
 	{
 		Main.ShareCurrentSource("*STDIN*");
 		Main.Rewrite(Unilang::ToReducer(Global.Allocator, [&](Context& ctx){
 			PrepareExecution(ctx);
+			if(UseStreaming)
+				return run_stream(std::cin, ctx);
 			Term = Global.ReadFrom(std::cin, Main);
 			return ExecuteOnce(ctx);
 		}));
@@ -325,8 +686,12 @@ Interpreter::RunScript(string filename)
 		Main.ShareCurrentSource(filename);
 		Main.Rewrite(Unilang::ToReducer(Global.Allocator, [&](Context& ctx){
 			PrepareExecution(ctx);
-			Term
-				= Global.ReadFrom(*OpenUnique(Main, std::move(filename)), Main);
+			if(UseStreaming)
+			{
+				p_is = OpenUnique(Main, std::move(filename));
+				return run_stream(*p_is, ctx);
+			}
+			Term = ReadFile(Main, std::move(filename));
 			return ExecuteOnce(ctx);
 		}));
 	}
@@ -373,31 +738,26 @@ Interpreter::WaitForLine()
 void
 DisplayTermValue(std::ostream& os, const TermNode& term)
 {
-	YSLib::stringstream oss(string(term.get_allocator()));
-
-	PrintTermNode(oss, term, [](std::ostream& os0, const TermNode& nd){
-		os0 << StringifyValueObjectForDisplay(nd.Value);
+	PrintTermNode(os, term, [](std::ostream& os0, const TermNode& nd){
+		return PrintValueObject(os0, nd.Value, {});
 	});
-	os << oss.str().c_str();
 }
 
 void
 PrintTermNode(std::ostream& os, const TermNode& term)
 {
 	PrintTermNode(os, term, [](std::ostream& os0, const TermNode& nd){
-		os0 << StringifyValueObject(nd.Value);
+		return PrintValueObject(os0, nd.Value);
 	});
 }
 
 void
 WriteTermValue(std::ostream& os, const TermNode& term)
 {
-	YSLib::stringstream oss(string(term.get_allocator()));
-
-	PrintTermNode(oss, term, [](std::ostream& os0, const TermNode& nd){
-		os0 << StringifyValueObjectForWrite(nd.Value);
+	// XXX: At current, this is just same to the "print" routine.
+	PrintTermNode(os, term, [](std::ostream& os0, const TermNode& nd){
+		return PrintValueObject(os0, nd.Value);
 	});
-	os << oss.str().c_str();
 }
 
 } // namespace Unilang;
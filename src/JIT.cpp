@@ -1,6 +1,14 @@
 ﻿// SPDX-FileCopyrightText: 2021-2022 UnionTech Software Technology Co.,Ltd.
 
 #include "JIT.h"
+#include "Evaluation.h" // for ExpandSharedCode, SharedCode, ReduceLeaf,
+//	FormContextHandler, ContextHandler, ReduceCombinedBranch;
+#include "TermAccess.h" // for IsCombiningTerm, TryAccessLeaf,
+//	TryAccessLeafAtom, TermReference, ClearCombiningTags;
+#include <algorithm> // for std::all_of;
+#include <iterator> // for std::next;
+#include "TCO.h" // for AssertNextTerm, EnsureTCOAction, RelayDirect;
+#include <cassert> // for assert;
 #if !UNILANG_NO_LLVM
 #if __GNUG__
 #	pragma GCC diagnostic push
@@ -57,10 +65,74 @@ Driver::Run()
 }
 
 
+YB_ATTR_nodiscard YB_PURE bool
+IsLeafCombination(const TermNode& term) noexcept
+{
+	return IsCombiningTerm(term) && IsList(term)
+		&& !IsSingleElementList(term) && !IsEmpty(AccessFirstSubterm(term))
+		&& std::all_of(term.begin(), term.end(), [](const TermNode& nd){
+		return IsLeaf(nd) && !TryAccessLeaf<const SharedCode>(nd);
+	});
+}
+
+// NOTE: The leaf is reduced by %ReduceLeaf directly rather than
+//	%Context::ReduceOnce, so no actions are set up and the result is ready
+//	before the return. The term shall not be a %SharedCode leaf.
+void
+ReduceLeafSynchronously(TermNode& nd, Context& ctx)
+{
+	ctx.SetNextTermRef(nd);
+
+	const auto res(ReduceLeaf(nd, ctx));
+
+	yunused(res);
+	assert((res == ReductionStatus::Neutral
+		|| res == ReductionStatus::Regular) && "Invalid status found.");
+}
+
+// NOTE: This is equivalent to %ReduceCombining, except that the operands of
+//	an applicative are evaluated in the loop without the asynchronous reducers
+//	of each operand, which is safe as the reduction of a leaf is synchronous.
+ReductionStatus
+ReduceLeafCombination(TermNode& term, Context& ctx)
+{
+	AssertNextTerm(ctx, term);
+
+	auto& fm(AccessFirstSubterm(term));
+
+	ctx.LastStatus = ReductionStatus::Neutral;
+	ctx.SetCombiningTermRef(term);
+	ReduceLeafSynchronously(fm, ctx);
+	if(const auto p_ref_fm = TryAccessLeafAtom<const TermReference>(fm))
+		if(const auto p_handler
+			= TryAccessLeafAtom<const ContextHandler>(p_ref_fm->get()))
+			if(const auto p_fch = p_handler->target<FormContextHandler>())
+				// NOTE: The calls are not counted here, see
+				//	%ReduceCombinedBranch.
+				if(p_fch->GetWrappingCount() == 1
+					&& !ctx.CombinerProfilePtr)
+				{
+					// NOTE: The handler is copied as %CombinerReturnThunk does,
+					//	since the operator is removed by the call.
+					const ContextHandler h(p_fch->Handler);
+
+					ClearCombiningTags(term);
+					EnsureTCOAction(ctx, term).AddOperator(ctx.OperatorName);
+					ctx.ClearCombiningTerm();
+					for(auto i(std::next(term.begin())); i != term.end(); ++i)
+						ReduceLeafSynchronously(*i, ctx);
+					ctx.SetNextTermRef(term);
+					return RelayDirect(ctx, h, term);
+				}
+	return ReduceCombinedBranch(term, ctx);
+}
+
 ReductionStatus
 JITReduceOnce(TermNode& term, Context& ctx)
 {
-	return Context::DefaultReduceOnce(term, ctx);
+	ExpandSharedCode(term);
+	return IsLeafCombination(term) ? ReduceLeafCombination(term, ctx)
+		: Context::DefaultReduceOnce(term, ctx);
 }
 
 } // unnamed namespace;
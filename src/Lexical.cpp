@@ -229,6 +229,32 @@ CategorizeBasicLexeme(string_view id) noexcept
 }
 
 
+TokenKind
+ClassifyLexeme(string_view id) noexcept
+{
+	assert(id.data());
+	if(id.size() == 1)
+		switch(id.front())
+		{
+		case '(':
+			return TokenKind::LeftParenthesis;
+		case ')':
+			return TokenKind::RightParenthesis;
+		case '[':
+			return TokenKind::LeftBracket;
+		case ']':
+			return TokenKind::RightBracket;
+		case '{':
+			return TokenKind::LeftBrace;
+		case '}':
+			return TokenKind::RightBrace;
+		default:
+			return TokenKind::Symbol;
+		}
+	return TokenKind(CategorizeBasicLexeme(id));
+}
+
+
 void
 ThrowMismatchBoundaryToken(char ldelim, char rdelim)
 {
@@ -5,13 +5,14 @@
 //	YSLib::ifstream, YSLib::istringstream;
 #include <cstdlib> // for std::getenv;
 #include "Context.h" // for Context, EnvironmentSwitcher,
-//	Unilang::SwitchToFreshEnvironment;
+//	Unilang::SwitchToFreshEnvironment, Unilang::EmplaceLeaf;
 #include <ystdex/scope_guard.hpp> // for ystdex::guard;
 #include <ystdex/invoke.hpp> // for ystdex::invoke;
 #include <functional> // for std::bind, std::placeholders;
 #include "BasicReduction.h" // for ReductionStatus, LiftOther;
 #include "Evaluation.h" // for RetainN, ValueToken, RegisterStrict,
-//	NameTypedContextHandler;
+//	NameTypedContextHandler, CombinerProfile;
+#include <chrono> // for std::chrono::duration;
 #include "Forms.h" // for Forms::CallRawUnary, Forms::CallBinaryFold and other
 //	form implementations;
 #include "Exception.h" // for ThrowNonmodifiableErrorForAssignee,
@@ -455,10 +456,9 @@ LoadModule_std_io(Interpreter& intp)
 		RetainN(term);
 		RefTCOAction(ctx).SaveTailSourceName(ctx.CurrentSource,
 			std::move(ctx.CurrentSource));
-		term = intp.Global.ReadFrom(*intp.OpenUnique(ctx, string(
+		term = intp.ReadFilePreprocessed(ctx, string(
 			Unilang::ResolveRegular<const string>(Unilang::Deref(
-			std::next(term.begin()))), term.get_allocator())), ctx);
-		intp.Global.Preprocess(term);
+			std::next(term.begin()))), term.get_allocator()));
 		return ctx.ReduceOnce.Handler(term, ctx);
 	});
 	RegisterUnary<Strict, const string>(renv, "open-input-file",
@@ -518,58 +518,219 @@ LoadModule_std_system(Interpreter& intp)
 	});
 }
 
+void
+LoadModule_std_profile(Interpreter& intp)
+{
+	using namespace Forms;
+	auto& renv(intp.Main.GetRecordRef());
+	// NOTE: The profile is shared by the contexts where it is started.
+	const auto p_prof(YSLib::make_shared<CombinerProfile>());
+
+	RegisterStrict(renv, "profile-start!", [=](TermNode& term, Context& ctx){
+		RetainN(term, 0);
+		ctx.CombinerProfilePtr = p_prof;
+		return ReduceReturnUnspecified(term);
+	});
+	RegisterStrict(renv, "profile-stop!", [](TermNode& term, Context& ctx){
+		RetainN(term, 0);
+		ctx.CombinerProfilePtr = {};
+		return ReduceReturnUnspecified(term);
+	});
+	RegisterStrict(renv, "profile-reset!", [=](TermNode& term, Context& ctx){
+		RetainN(term, 0);
+		p_prof->Reset();
+		yunseq(ctx.CompressedFrameRecords = 0, ctx.MaxFrameRecords = 0);
+		return ReduceReturnUnspecified(term);
+	});
+	RegisterStrict(renv, "profile-report", [=](TermNode& term){
+		RetainN(term, 0);
+		p_prof->PrintReport(std::cout);
+		return ReduceReturnUnspecified(term);
+	});
+	RegisterStrict(renv, "profile-memory-report", [&](TermNode& term){
+		RetainN(term, 0);
+		if(const auto p = dynamic_cast<const TrackingResource*>(
+			&intp.GetMemoryResourceRef()))
+			p->PrintStatistics(std::cout);
+		else
+			std::cout << "No memory statistics available." << std::endl;
+		return ReduceReturnUnspecified(term);
+	});
+	RegisterStrict(renv, "profile-data", [=](TermNode& term){
+		RetainN(term, 0);
+
+		const auto a(term.get_allocator());
+		TermNode::Container con(a);
+
+		for(const auto& pr : p_prof->Entries)
+			if(pr.second.Calls != 0)
+			{
+				TermNode::Container entry(a);
+
+				TermNode::AddValueTo(entry, string(pr.first, a));
+				TermNode::AddValueTo(entry, pr.second.Calls);
+				TermNode::AddValueTo(entry, std::chrono::duration<double>(
+					pr.second.Time).count());
+				con.emplace_back(std::move(entry));
+			}
+		con.swap(term.GetContainerRef());
+		return ReductionStatus::Retained;
+	});
+	RegisterStrict(renv, "profile-tco-data", [](TermNode& term, Context& ctx){
+		RetainN(term, 0);
+
+		TermNode::Container con(term.get_allocator());
+
+		TermNode::AddValueTo(con, ctx.CompressedFrameRecords);
+		TermNode::AddValueTo(con, ctx.MaxFrameRecords);
+		con.swap(term.GetContainerRef());
+		return ReductionStatus::Retained;
+	});
+}
+
+// NOTE: The native registry and resolver of the requirements used by
+//	%require in the module %std.modules.
+class RequirementResolver final
+{
+private:
+	using Table = map<string, bool, ystdex::less<>>;
+
+	// NOTE: The requirements ever registered, mapped to whether they are
+	//	registered currently.
+	Table registry;
+	// NOTE: The path templates are initialized by %UNILANG_PATH once they are
+	//	used, and '?' in them is the placeholder of the requirement name.
+	vector<string> specs;
+	bool specs_ready = {};
+
+public:
+	RequirementResolver(TermNode::allocator_type a)
+		: registry(a), specs(a)
+	{}
+
+	YB_ATTR_nodiscard bool
+	IsRegistered(const string& req) const
+	{
+		CheckRequirement(req);
+
+		const auto i(registry.find(req));
+
+		return i != registry.cend() && i->second;
+	}
+
+	void
+	Register(const string& req)
+	{
+		CheckRequirement(req);
+
+		auto& registered(registry[req]);
+
+		if(registered)
+			throw UnilangException(ystdex::sfmt(
+				"Requirement '%s' is already registered.", req.c_str()));
+		registered = true;
+	}
+
+	void
+	Unregister(const string& req)
+	{
+		CheckRequirement(req);
+
+		const auto i(registry.find(req));
+
+		if(i == registry.end() || !i->second)
+			throw UnilangException(ystdex::sfmt(
+				"Requirement '%s' is not registered.", req.c_str()));
+		i->second = {};
+	}
+
+	// NOTE: The results of the probing are not cached, so the files created or
+	//	removed later are respected. The registered requirements are not
+	//	found again by %require.
+	YB_ATTR_nodiscard string
+	Find(const string& req)
+	{
+		CheckRequirement(req);
+		PrepareSpecs();
+		for(const auto& spec : specs)
+		{
+			string path(req.get_allocator());
+
+			for(const char c : spec)
+				if(c == '?')
+					path += req;
+				else
+					path += c;
+			if(YSLib::ufexists(path.c_str()))
+				return path;
+		}
+		throw UnilangException(ystdex::sfmt(
+			"No module for requirement '%s' found.", req.c_str()));
+	}
+
+private:
+	static void
+	CheckRequirement(const string& req)
+	{
+		if(req.empty())
+			throw UnilangException("Empty requirement name found.");
+	}
+
+	void
+	PrepareSpecs()
+	{
+		if(!specs_ready)
+		{
+			string spec(specs.get_allocator());
+
+			YSLib::FetchEnvironmentVariable(spec, "UNILANG_PATH");
+			if(!spec.empty())
+			{
+				string::size_type pos(0), orig(0);
+
+				while((pos = spec.find(';', pos)) != string::npos)
+				{
+					specs.push_back(spec.substr(orig, pos - orig));
+					orig = ++pos;
+				}
+				specs.push_back(spec.substr(orig));
+			}
+			else
+				for(const auto str : {"./?", "./?.u", "./?.txt"})
+					specs.emplace_back(str);
+			specs_ready = true;
+		}
+	}
+};
+
 void
 LoadModule_std_modules(Interpreter& intp)
 {
-	intp.Perform(R"Unilang(
-$provide/let! (registered-requirement? register-requirement!
-	unregister-requirement! find-requirement-filename)
-((mods $as-environment (
-	$import! std.strings &string-empty? &++ &string->symbol;
+	using namespace Forms;
+	auto& renv(intp.Main.GetRecordRef());
+	// NOTE: The resolver is shared by the handlers in the module.
+	const auto p_resolver(YSLib::make_shared<RequirementResolver>(
+		intp.Global.Allocator));
 
-	$defl! requirement-error ()
-		raise-error "Empty requirement name found.",
-	(
-	$def! registry () make-environment;
-	$defl! bound-name? (&req)
-		$and (eval (list bound? req) registry)
-			(not? (string-empty? (eval (string->symbol req) registry))),
-	$defl! set-value! (&req &v)
-		eval (list $def! (string->symbol req) v) registry
-	),
-	$def! prom_pathspecs ($remote-eval% $lazy std.promises)
-		$let ((spec ($remote-eval% env-get std.system) "UNILANG_PATH"))
-			$if (string-empty? spec) (list "./?" "./?.u" "./?.txt")
-				(($remote-eval% string-split std.strings) spec ";"),
-	(
-	$def! placeholder ($remote-eval% string->regex std.strings) "\?",
-	$defl! get-requirement-filename (&specs &req)
-		$if (null? specs)
-			(raise-error (++ "No module for requirement '" req
-				"' found."))
-			(
-				$let* ((spec first& specs) (path ($remote-eval% regex-replace
-					std.strings) spec placeholder req))
-					$if (($remote-eval% readable-file? std.io) path) path
-						(get-requirement-filename (rest& specs) req)
-			)
-	)
-)))
-(
-	$defl/e! &registered-requirement? mods (&req)
-		$if (string-empty? req) (() requirement-error) (bound-name? req),
-	$defl/e! &register-requirement! mods (&req)
-		$if (string-empty? req) (() requirement-error)
-			($if (bound-name? req) (raise-error (++ "Requirement '" req
-				"' is already registered.")) (set-value! req req)),
-	$defl/e! &unregister-requirement! mods (&req)
-		$if (string-empty? req) (() requirement-error)
-			($if (bound-name? req) (set-value! req "") (raise-error
-				(++ "Requirement '" req "' is not registered."))),
-	$defl/e! &find-requirement-filename mods (&req)
-		get-requirement-filename
-			(($remote-eval% force std.promises) prom_pathspecs) req
-);
+	RegisterUnary<Strict, const string>(renv, "registered-requirement?",
+		[=](const string& req){
+		return p_resolver->IsRegistered(req);
+	});
+	RegisterUnary<Strict, const string>(renv, "register-requirement!",
+		[=](const string& req){
+		p_resolver->Register(req);
+		return ValueToken::Unspecified;
+	});
+	RegisterUnary<Strict, const string>(renv, "unregister-requirement!",
+		[=](const string& req){
+		p_resolver->Unregister(req);
+		return ValueToken::Unspecified;
+	});
+	RegisterUnary<Strict, const string>(renv, "find-requirement-filename",
+		[=](const string& req){
+		return p_resolver->Find(req);
+	});
+	intp.Perform(R"Unilang(
 $defl%! require (&req)
 	$if (registered-requirement? req) #inert
 		($let ((filename find-requirement-filename req))
@@ -584,7 +745,7 @@ PreloadExternal(Interpreter& intp, const char* filename)
 	try
 	{
 		auto& ctx(intp.Main);
-		auto term(intp.Global.ReadFrom(*intp.OpenUnique(ctx, filename), ctx));
+		auto term(intp.ReadFile(ctx, filename));
 
 		intp.Evaluate(term);
 	}
@@ -605,7 +766,7 @@ LoadFunctions(Interpreter& intp, bool jit, int& argc, char* argv[])
 
 	if(jit)
 		SetupJIT(ctx);
-	renv.Bindings["ignore"].Value = ValueToken::Ignore;
+	Unilang::EmplaceLeaf<ValueToken>(renv, "ignore", ValueToken::Ignore);
 	RegisterStrict(ctx, "eq?", Eq);
 	RegisterStrict(ctx, "eql?", EqLeaf);
 	RegisterStrict(ctx, "eqv?", EqValue);
@@ -717,6 +878,11 @@ $def! $lambda/e% $vau (&p &formals .&body) d
 		(cons p (cons% (forward! formals) (cons% #ignore (forward! body))))) d);
 	)Unilang");
 	RegisterForm(ctx, "$sequence", Sequence);
+	RegisterForm(ctx, "$cond", Cond);
+	RegisterForm(ctx, "$when", When);
+	RegisterForm(ctx, "$unless", Unless);
+	RegisterForm(ctx, "$and", And);
+	RegisterForm(ctx, "$or", Or);
 	intp.Perform(R"Unilang(
 $def! collapse $lambda% (%x)
 	$if (uncollapsed? x) (($if ($lvalue-identifier? x) ($lambda% (%x) x) id)
@@ -800,15 +966,6 @@ $defl! equal? (&x &y)
 		($if (equal? (first& x) (first& y)) (equal? (rest& x) (rest& y)) #f)
 		(eqv? x y);
 $defl%! check-environment (&e) $sequence (eval% #inert e) (forward! e);
-$defv%! $cond &clauses d
-	$if (null? clauses) #inert
-		(apply-list ($lambda% ((&test .&body) .&clauses)
-			$if (eval test d) (eval% (forward! body) d)
-			(apply (wrap $cond) (forward! clauses) d)) (forward! clauses));
-$defv%! $when (&test .&exprseq) d
-	$if (eval test d) (eval% (list* () $sequence (forward! exprseq)) d);
-$defv%! $unless (&test .&exprseq) d
-	$if (eval test d) #inert (eval% (list* () $sequence (forward! exprseq)) d);
 $defv%! $while (&test .&exprseq) d
 	$when (eval test d)
 		(eval% (list* () $sequence exprseq) d)
@@ -818,18 +975,6 @@ $defv%! $until (&test .&exprseq) d
 		(eval% (list* () $sequence exprseq) d)
 		(eval% (list* () $until (forward! test) (forward! exprseq)) d);
 $defl! not? (x) eqv? x #f;
-$defv%! $and &x d
-	$cond
-		((null? x) #t)
-		((null? (rest& x)) eval% (first (forward! x)) d)
-		((eval% (first& x) d) eval% (cons% $and (rest% (forward! x))) d)
-		(#t #f);
-$defv%! $or &x d
-	$cond
-		((null? x) #f)
-		((null? (rest& x)) eval% (first (forward! x)) d)
-		(#t ($lambda% (&r) $if r (forward! r) (eval%
-			(cons% $or (rest% (forward! x))) d)) (eval% (move! (first& x)) d));
 $defl%! and &x $sequence
 	($defl%! and-aux (&h &l) $if (null? l) (forward! h)
 		(and-aux ($if h (forward! (first% l)) #f) (forward! (rest% l))))
@@ -959,6 +1104,7 @@ $defv! $import! (&e .&symbols) d
 	load_std_module("math", LoadModule_std_math);
 	load_std_module("io", LoadModule_std_io);
 	load_std_module("system", LoadModule_std_system);
+	load_std_module("profile", LoadModule_std_profile);
 	load_std_module("modules", LoadModule_std_modules);
 	// NOTE: Additional standard library initialization.
 	PreloadExternal(intp, "std.txt");
@@ -1006,6 +1152,22 @@ const std::array<const char*, 3> DeEnvs[]{
 	{{"UNILANG_NO_SRCINFO", "", "If set, disable the source information from"
 		" the source code for diagnostics. The source names are used"
 		" regardless of this variable."}},
+	{{"UNILANG_MEMORY_RESOURCE", "", "The memory resource used by the"
+		" interpreter. The value shall be one of 'default', 'pool',"
+		" 'sync-pool', 'monotonic' and 'tracking'. The empty value is same to"
+		" 'default'. The statistics are printed to the standard log on exit"
+		" for 'tracking'."}},
+	{{"UNILANG_PROFILE", "", "If set, enable the sampling profiler. The"
+		" samples are written as folded stacks on exit to the file named by the"
+		" value, or to the standard log if the value is empty."}},
+	{{"UNILANG_PROFILE_PERIOD", "", "The number of the tail actions between"
+		" the samples of the profiler. The default value is 1000."}},
+	{{"UNILANG_STREAMING", "", "If set, read and evaluate the top-level forms"
+		" separated by ';' in the script one by one, instead of reading the"
+		" whole script before the evaluation."}},
+	{{"UNILANG_CACHE", "", "If not empty, the name of the existing directory"
+		" caching the preprocessed files loaded by 'load', including the"
+		" modules by 'require'."}},
 	{{"UNILANG_PATH", "", "Unilang loader path template string."}}
 };
 
@@ -1076,8 +1238,17 @@ constexpr auto
 
 } // unnamed namespace;
 
+void
+LoadStandardLibrary(Interpreter& intp, int& argc, char* argv[])
+{
+	LoadFunctions(intp, Unilang_UseJIT, argc, argv);
+}
+
 } // namespace Unilang;
 
+// NOTE: The macro %Unilang_NoMain is defined when the sources are linked into
+//	other programs, e.g. the benchmark harness.
+#ifndef Unilang_NoMain
 int
 main(int argc, char* argv[])
 {
@@ -1173,4 +1344,5 @@ main(int argc, char* argv[])
 		}
 	}, yfsig, YSLib::Alert) ? EXIT_FAILURE : EXIT_SUCCESS;
 }
+#endif
 
@@ -15,6 +15,8 @@
 #include <ystdex/functional.hpp> // for ystdex::retry_on_cond, ystdex::id;
 #include <ystdex/cctype.h> // for ystdex::isdigit;
 #include "BasicReduction.h" // for ReductionStatus;
+#include <array> // for std::array;
+#include <cstdint> // for std::uintptr_t;
 
 namespace Unilang
 {
@@ -66,7 +68,7 @@ enum NumCode : size_t
 };
 
 YB_ATTR_nodiscard YB_PURE NumCode
-MapTypeIdToNumCode(const type_info& ti) noexcept
+MapTypeIdToNumCodeSlow(const type_info& ti) noexcept
 {
 	if(IsTyped<int>(ti))
 		return Int;
@@ -96,6 +98,74 @@ MapTypeIdToNumCode(const type_info& ti) noexcept
 		return LongDouble;
 	return None;
 }
+
+
+// NOTE: The numeric type codes are cached by the addresses of the type
+//	information objects, so the dispatch is usually a single probe. Other
+//	type information objects (e.g. from other modules) fall back to the
+//	comparisons.
+class NumCodeTable final
+{
+private:
+	static constexpr size_t SlotCount = 32;
+
+	std::array<pair<const type_info*, NumCode>, SlotCount> slots{};
+
+public:
+	NumCodeTable() noexcept
+	{
+		Add<signed char>(SChar);
+		Add<unsigned char>(UChar);
+		Add<short>(Short);
+		Add<unsigned short>(UShort);
+		Add<int>(Int);
+		Add<unsigned>(UInt);
+		Add<long>(Long);
+		Add<unsigned long>(ULong);
+		Add<long long>(LongLong);
+		Add<unsigned long long>(ULongLong);
+		Add<float>(Float);
+		Add<double>(Double);
+		Add<long double>(LongDouble);
+	}
+
+	YB_ATTR_nodiscard YB_PURE NumCode
+	operator[](const type_info& ti) const noexcept
+	{
+		for(auto i(GetIndex(ti)); slots[i].first; i = (i + 1) % SlotCount)
+			if(slots[i].first == &ti)
+				return slots[i].second;
+		return MapTypeIdToNumCodeSlow(ti);
+	}
+
+private:
+	template<typename _type>
+	void
+	Add(NumCode code) noexcept
+	{
+		const auto& ti(type_id<_type>());
+		auto i(GetIndex(ti));
+
+		while(slots[i].first)
+			i = (i + 1) % SlotCount;
+		slots[i] = {&ti, code};
+	}
+
+	YB_ATTR_nodiscard YB_STATELESS static size_t
+	GetIndex(const type_info& ti) noexcept
+	{
+		return size_t(reinterpret_cast<std::uintptr_t>(&ti)
+			/ alignof(type_info)) % SlotCount;
+	}
+};
+
+YB_ATTR_nodiscard YB_PURE NumCode
+MapTypeIdToNumCode(const type_info& ti) noexcept
+{
+	static const NumCodeTable tbl;
+
+	return tbl[ti];
+}
 YB_ATTR_nodiscard YB_PURE inline NumCode
 MapTypeIdToNumCode(const ValueObject& vo) noexcept
 {
@@ -162,39 +232,6 @@ template<typename _type>
 using MakeMulExtType = ystdex::_t<MulExtType<_type>>;
 
 
-template<typename _type, typename _func, class _tValue>
-YB_ATTR_nodiscard _type
-DoNumLeaf(_tValue& x, _func f)
-{
-	if(const auto p_i = TryAccessValue<int>(x))
-		return f(*p_i);
-	if(const auto p_u = TryAccessValue<unsigned>(x))
-		return f(*p_u);
-	if(const auto p_ll = TryAccessValue<long long>(x))
-		return f(*p_ll);
-	if(const auto p_ull = TryAccessValue<unsigned long long>(x))
-		return f(*p_ull);
-	if(const auto p_d = TryAccessValue<double>(x))
-		return f(*p_d);
-	if(const auto p_l = TryAccessValue<long>(x))
-		return f(*p_l);
-	if(const auto p_ul = TryAccessValue<unsigned long>(x))
-		return f(*p_ul);
-	if(const auto p_s = TryAccessValue<short>(x))
-		return f(*p_s);
-	if(const auto p_us = TryAccessValue<unsigned short>(x))
-		return f(*p_us);
-	if(const auto p_sc = TryAccessValue<signed char>(x))
-		return f(*p_sc);
-	if(const auto p_uc = TryAccessValue<unsigned char>(x))
-		return f(*p_uc);
-	if(const auto p_f = TryAccessValue<float>(x))
-		return f(*p_f);
-	if(const auto p_ld = TryAccessValue<long double>(x))
-		return f(*p_ld);
-	return f(x);
-}
-
 template<typename _type, class... _tValue, typename _func>
 YB_ATTR_nodiscard _type
 DoNumLeafHinted(NumCode code, _func f, _tValue&... xs)
@@ -232,6 +269,13 @@ DoNumLeafHinted(NumCode code, _func f, _tValue&... xs)
 	}
 }
 
+template<typename _type, typename _func, class _tValue>
+YB_ATTR_nodiscard _type
+DoNumLeaf(_tValue& x, _func f)
+{
+	return DoNumLeafHinted<_type>(MapTypeIdToNumCode(x), f, x);
+}
+
 
 template<typename _type>
 YB_ATTR_nodiscard YB_PURE inline ValueObject
@@ -1034,6 +1078,9 @@ NumBinaryComp(const ValueObject& x, const ValueObject& y) noexcept
 		return DoNumLeafHinted<bool>(code, GBOp<_fBinary, bool>(), u, v);
 	});
 
+	// NOTE: Operands of the same type are neither copied nor promoted.
+	if(xcode == ycode && xcode != None)
+		return DoNumLeafHinted<bool>(xcode, GBOp<_fBinary, bool>(), x, y);
 	return size_t(xcode) >= size_t(ycode) ? ret_bin(x, Promote(xcode, y, ycode),
 		xcode) : ret_bin(Promote(ycode, x, xcode), y, ycode);
 }
@@ -1048,6 +1095,10 @@ NumBinaryOp(ResolvedArg<>& x, ResolvedArg<>& y)
 		return DoNumLeafHinted<_tRet>(code, GBOp<_fBinary, _tRet>(), u, v);
 	});
 
+	// NOTE: Ditto.
+	if(xcode == ycode && xcode != None)
+		return DoNumLeafHinted<_tRet>(xcode, GBOp<_fBinary, _tRet>(),
+			x.get().Value, y.get().Value);
 	return size_t(xcode) >= size_t(ycode) ?
 		ret_bin(MoveUnary(x), Promote(xcode, y.get().Value, ycode), xcode)
 		: ret_bin(Promote(ycode, x.get().Value, xcode), MoveUnary(y), ycode);
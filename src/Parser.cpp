@@ -3,6 +3,11 @@
 #include "Parser.h"
 #include <cassert> // for assert;
 #include "Lexical.h" // for IsDelimiter, IsGraphicalDelimiter;
+#include <cstring> // for std::memchr;
+#if __SSE2__
+#	include <emmintrin.h> // for __m128i, _mm_loadu_si128, _mm_set1_epi8,
+//	_mm_cmpeq_epi8, _mm_max_epu8, _mm_or_si128, _mm_movemask_epi8;
+#endif
 
 namespace Unilang
 {
@@ -102,6 +107,157 @@ struct SourcedSequenceAppend final
 	}
 };
 
+
+YB_ATTR_nodiscard YB_STATELESS constexpr bool
+IsBoundaryCandidate(char c) noexcept
+{
+	// NOTE: All whitespace characters are not greater than the space. Other
+	//	characters in the range are rejected later.
+	return static_cast<unsigned char>(c) <= ' ' || IsGraphicalDelimiter(c)
+		|| c == '\'' || c == '"' || c == '\\';
+}
+
+// NOTE: This finds the first character which may end an unquoted lexeme, or
+//	start a literal or an escape sequence.
+YB_ATTR_nodiscard YB_PURE const char*
+FindBoundaryCandidate(const char* p, const char* e) noexcept
+{
+#if __SSE2__
+	static const char delims[]{'(', ')', ',', ';', '[', ']', '{', '}', '\'',
+		'"', '\\'};
+	const auto space(_mm_set1_epi8(' '));
+
+	for(; e - p >= 16; p += 16)
+	{
+		const auto v(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p)));
+		auto m(_mm_cmpeq_epi8(_mm_max_epu8(v, space), space));
+
+		for(const char c : delims)
+			m = _mm_or_si128(m, _mm_cmpeq_epi8(v, _mm_set1_epi8(c)));
+		if(const auto mask = unsigned(_mm_movemask_epi8(m)))
+			return p + __builtin_ctz(mask);
+	}
+#endif
+	while(p != e && !IsBoundaryCandidate(*p))
+		++p;
+	return p;
+}
+
+// NOTE: This finds the first quotation mark specified by the delimiter or the
+//	first backslash in a literal.
+YB_ATTR_nodiscard YB_PURE const char*
+FindLiteralBoundary(const char* p, const char* e, char ld) noexcept
+{
+#if __SSE2__
+	const auto quote(_mm_set1_epi8(ld)), backslash(_mm_set1_epi8('\\'));
+
+	for(; e - p >= 16; p += 16)
+	{
+		const auto v(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p)));
+
+		if(const auto mask = unsigned(_mm_movemask_epi8(_mm_or_si128(
+			_mm_cmpeq_epi8(v, quote), _mm_cmpeq_epi8(v, backslash)))))
+			return p + __builtin_ctz(mask);
+	}
+#endif
+	while(p != e && *p != ld && *p != '\\')
+		++p;
+	return p;
+}
+
+template<typename _fAdd>
+bool
+ScanInPlace(string_view src, _fAdd add, bool sourced)
+{
+	const char* p(src.data());
+	const char* const e(p + src.size());
+	const char* lex = {};
+	char ld = {};
+	SourceLocation lex_loc;
+	size_t line(0);
+	const char* line_start(p);
+	const auto count_lines([&](const char* first, const char* last){
+		if(sourced)
+			while(const auto q = static_cast<const char*>(
+				std::memchr(first, '\n', size_t(last - first))))
+			{
+				++line;
+				first = line_start = q + 1;
+			}
+	});
+	const auto open([&](const char* q){
+		if(!lex)
+		{
+			lex = q;
+			lex_loc = SourceLocation(line, size_t(q - line_start));
+		}
+	});
+	const auto close([&](const char* q){
+		if(lex)
+		{
+			add(string_view(lex, size_t(q - lex)), lex_loc);
+			lex = {};
+		}
+	});
+
+	while(p != e)
+		if(ld == char())
+		{
+			const char c(*p);
+
+			if(c == '\\')
+				return {};
+			if(c == '\'' || c == '"')
+			{
+				open(p++);
+				ld = c;
+			}
+			else if(IsDelimiter(c))
+			{
+				close(p);
+				if(IsGraphicalDelimiter(c))
+				{
+					open(p);
+					close(p + 1);
+				}
+				else if(c == '\n')
+					yunseq(++line, line_start = p + 1);
+				++p;
+			}
+			else
+			{
+				open(p);
+				p = FindBoundaryCandidate(p + 1, e);
+			}
+		}
+		else
+		{
+			const auto q(FindLiteralBoundary(p, e, ld));
+
+			count_lines(p, q);
+			if(q == e)
+				p = e;
+			else if(*q == '\\')
+			{
+				// NOTE: The escaped character is kept in the lexeme.
+				p = q + 1;
+				if(p != e)
+				{
+					count_lines(p, p + 1);
+					++p;
+				}
+			}
+			else
+			{
+				ld = char();
+				p = q + 1;
+				close(p);
+			}
+		}
+	close(e);
+	return true;
+}
+
 } // unnamed namespace;
 
 
@@ -121,5 +277,47 @@ SourcedByteParser::Update(bool got_delim)
 		GetBufferRef(), update_current);
 }
 
+
+bool
+ViewParser::operator()(string_view src)
+{
+	lexemes.clear();
+	if(ScanInPlace(src, [this](string_view lexeme, const SourceLocation&){
+		lexemes.push_back(MakeLexemeToken(lexeme));
+	}, {}))
+		return true;
+	lexemes.clear();
+	return {};
+}
+
+
+bool
+SourcedViewParser::operator()(string_view src)
+{
+	lexemes.clear();
+	if(ScanInPlace(src, [this](string_view lexeme, const SourceLocation& loc){
+		lexemes.emplace_back(loc, MakeLexemeToken(lexeme));
+	}, true))
+		return true;
+	lexemes.clear();
+	return {};
+}
+
+
+string
+UnescapeLexeme(string_view lexeme, pmr::polymorphic_allocator<byte> a)
+{
+	LexicalAnalyzer lexer;
+	ByteParser parse(lexer, a);
+
+	for(const char c : lexeme)
+		parse(c);
+
+	auto& res(parse.GetResultRef());
+
+	assert(res.size() == 1 && "Invalid lexeme found.");
+	return std::move(res.front());
+}
+
 } // namespace Unilang;
 
@@ -5,12 +5,13 @@
 #include <ystdex/scope_guard.hpp> // for ystdex::dismiss;
 #include <ystdex/functional.hpp> // for ystdex::retry_on_cond, ystdex::id;
 #include "Exception.h" // for UnilangException;
+#include <algorithm> // for std::max;
 
 namespace Unilang
 {
 
 RecordCompressor::RecordCompressor(const shared_ptr<Environment>& p_root)
-	: RecordCompressor(p_root, p_root->Bindings.get_allocator())
+	: RecordCompressor(p_root, p_root->get_allocator())
 {}
 RecordCompressor::RecordCompressor(const shared_ptr<Environment>& p_root,
 	Environment::allocator_type a)
@@ -89,6 +90,7 @@ RecordCompressor::Compress()
 				if(!ystdex::exists(Universe, ystdex::ref(dst)))
 					return true;
 				parent = dst.Parent;
+				src.NotifyModified();
 				collected = true;
 			}
 			return {};
@@ -97,6 +99,25 @@ RecordCompressor::Compress()
 	});
 }
 
+bool
+RecordCompressor::IsCompressible(Environment& e)
+{
+	const auto& tp(e.Parent.type());
+
+	if(IsTyped<EnvironmentReference>(tp)
+		|| IsTyped<shared_ptr<Environment>>(tp))
+	{
+		bool res = {};
+
+		Traverse(e, e.Parent, [&](const shared_ptr<Environment>& p_dst){
+			res = CountReferences(p_dst) <= 1;
+			return false;
+		});
+		return res;
+	}
+	return IsTyped<EnvironmentList>(tp);
+}
+
 size_t
 RecordCompressor::CountReferences(const shared_ptr<Environment>& p) noexcept
 {
@@ -148,28 +169,33 @@ TCOAction::operator()(Context& ctx) const
 }
 
 void
-TCOAction::CompressFrameList()
+TCOAction::CompressFrameList(Context& ctx)
 {
-	ystdex::retry_on_cond(ystdex::id<>(), [&]() -> bool{
-		bool removed = {};
-		decltype(record_list) spliced(record_list.get_allocator());
-		auto i(record_list.cbefore_begin());
-		const auto last(record_list.cend());
+	size_t n(0), m(0);
+	auto i(record_list.cbefore_begin());
+
+	// NOTE: The records are destroyed in the pass. A destroyed record can only
+	//	release the references to the environments of the older records in
+	//	practice, which are checked later in the same pass. Any records left
+	//	removable are removed by the next call, so the list is still bounded
+	//	in proper tail calls without the restarts from the head.
+	for(auto j(std::next(i)); j != record_list.cend(); j = std::next(i))
+	{
+		const auto& p_env(std::get<ActiveEnvironmentPtr>(*j));
 
-		while(std::next(i) != last)
+		if(p_env.use_count() != 1 || Unilang::Deref(p_env).IsOrphan())
 		{
-			const auto& p_env(std::get<ActiveEnvironmentPtr>(*std::next(i)));
-
-			if(p_env.use_count() != 1 || Unilang::Deref(p_env).IsOrphan())
-			{
-				spliced.splice_after(spliced.cbefore_begin(), record_list, i);
-				removed = true;
-			}
-			else
-				++i;
+			record_list.erase_after(i);
+			++n;
 		}
-		return removed;
-	});
+		else
+		{
+			++i;
+			++m;
+		}
+	}
+	ctx.CompressedFrameRecords += n;
+	ctx.MaxFrameRecords = std::max(ctx.MaxFrameRecords, m);
 }
 
 void
@@ -8,10 +8,70 @@
 #include <ystdex/functional.hpp> // for ystdex::compose, std::mem_fn,
 //	ystdex::invoke_value_or;
 #include "Context.h" // for complete Environment;
+#include <ystdex/functor.hpp> // for ystdex::less;
 
 namespace Unilang
 {
 
+namespace
+{
+
+using YSLib::lock_guard;
+using YSLib::mutex;
+mutex SymbolTableMutex;
+
+using SymbolTable = map<string, SymbolAtom, ystdex::less<>>;
+
+YB_ATTR_nodiscard SymbolTable&
+FetchSymbolTableRef()
+{
+	// XXX: The table is deliberately leaked to be usable during the static
+	//	destruction of other objects.
+	static SymbolTable& tbl(*new SymbolTable());
+
+	return tbl;
+}
+
+// NOTE: The atoms already known by the current thread. The keys refer to the
+//	names in the global table, which are never removed or modified.
+using SymbolCache = map<string_view, SymbolAtom>;
+
+YB_ATTR_nodiscard SymbolCache&
+FetchSymbolCacheRef()
+{
+	// XXX: Same to the table, the cache is leaked to be usable during the
+	//	destruction of the objects with static or thread storage duration.
+	static thread_local SymbolCache& cache(*new SymbolCache());
+
+	return cache;
+}
+
+} // unnamed namespace;
+
+SymbolAtom
+InternSymbol(string_view id)
+{
+	assert(id.data());
+
+	auto& cache(FetchSymbolCacheRef());
+	auto j(cache.lower_bound(id));
+
+	// NOTE: The lock is only needed for the names new to the current thread.
+	if(j == cache.end() || id < j->first)
+	{
+		lock_guard<mutex> gd(SymbolTableMutex);
+		auto& tbl(FetchSymbolTableRef());
+		auto i(tbl.lower_bound(id));
+
+		if(i == tbl.end() || tbl.key_comp()(id, i->first))
+			// NOTE: The atom 0 is reserved.
+			i = tbl.emplace_hint(i, string(id), tbl.size() + 1);
+		j = cache.emplace_hint(j, string_view(i->first), i->second);
+	}
+	return j->second;
+}
+
+
 string
 TermToString(const TermNode& term, size_t n_skip)
 {
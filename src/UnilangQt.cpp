@@ -224,9 +224,10 @@ InitializeQtNative(Interpreter& intp, int& argc, char* argv[])
 		});
 		return ReduceReturnUnspecified(term);
 	});
-	renv.Bindings["Qt.AA_EnableHighDpiScaling"].Value
-		= Qt::AA_EnableHighDpiScaling;
-	renv.Bindings["Qt.AlignCenter"].Value = Qt::AlignCenter;
+	Unilang::EmplaceLeaf<Qt::ApplicationAttribute>(renv,
+		"Qt.AA_EnableHighDpiScaling", Qt::AA_EnableHighDpiScaling);
+	Unilang::EmplaceLeaf<Qt::AlignmentFlag>(renv, "Qt.AlignCenter",
+		Qt::AlignCenter);
 	RegisterStrict(rctx, "QCoreApplication-setAttribute", [](TermNode& term){
 		const auto n(FetchArgumentN(term));
 
@@ -384,9 +385,9 @@ InitializeQt(Interpreter& intp, int& argc, char* argv[])
 {
 	auto& rctx(intp.Main);
 
-	rctx.GetRecordRef().Bindings["UnilangQt.native__"].Value
-		= GetModuleFor(rctx, std::bind(InitializeQtNative, std::ref(intp),
-		std::ref(argc), argv));
+	Unilang::EmplaceLeaf<shared_ptr<Environment>>(rctx, "UnilangQt.native__",
+		GetModuleFor(rctx, std::bind(InitializeQtNative, std::ref(intp),
+		std::ref(argc), argv)));
 	intp.Perform(R"Unilang(
 		$def! UnilangQt $let ()
 		(
@@ -25,6 +25,14 @@ call_intp()
 	set -e
 }
 
+call_script()
+{
+	set +e
+	echo > "$ERR"
+	"$UNILANG" "$1" 1> "$OUT" 2> "$ERR"
+	set -e
+}
+
 # NOTE: Test cases should print no errors.
 run_case()
 {
@@ -38,6 +46,13 @@ run_case()
 	fi
 }
 
+# NOTE: The case is run with the environment variable set to the value.
+run_case_with()
+{
+	echo "With $1=$2:"
+	(export "$1=$2"; run_case "$3")
+}
+
 if [[ "$PTC" != '' ]]; then
 # NOTE: Test cases should print no errors.
 	echo "The following case are expected to be non-terminating."
@@ -46,9 +61,125 @@ if [[ "$PTC" != '' ]]; then
 	run_case '$defl! f (n) $if #t (f n); f 1'
 fi
 
+# NOTE: The script file is run with %UNILANG_STREAMING set. If the 2nd
+#	parameter exists, it is the expected output. If the 3rd parameter is not
+#	empty, an error is expected after the output.
+run_streaming_case()
+{
+	echo "Running script with UNILANG_STREAMING set:" "$1"
+	(export UNILANG_STREAMING=1; call_script "$1")
+	if [[ "$#" -gt 1 && "$(cat "$OUT")" != "$2" ]]; then
+		echo "FAIL."
+		echo "Error: The output is not '$2'."
+		cat "$ERR"
+	elif [[ "$3" == '' && -s "$ERR" ]]; then
+		echo "FAIL."
+		echo "Error:"
+		cat "$ERR"
+	elif [[ "$3" != '' && ! -s "$ERR" ]]; then
+		echo "FAIL."
+		echo "Error: No error is reported."
+	else
+		echo "PASS."
+	fi
+}
+
+# NOTE: The case is expected to report the error containing the 2nd parameter.
+run_error_case()
+{
+	echo "Running case with the error:" "$1"
+	(call_intp "$1")
+	if grep -qF -- "$2" "$ERR"; then
+		echo "PASS."
+	else
+		echo "FAIL."
+		echo "Error: No error is reported with: $2"
+		cat "$ERR"
+	fi
+}
+
+# NOTE: The case is run twice with the environment variable specifying the
+#	same cache, where the 1st run makes the cache and the 2nd run uses it. Both
+#	runs should print no errors and have the same output. The 4th parameter
+#	specifies the directory which should be populated by the 1st run.
+run_cached_case()
+{
+	local out_cold
+
+	echo "Running case with $1 set:" "$3"
+	export "$1=$2"
+	if (call_intp "$3") && [ ! -s "$ERR" ]; then
+		out_cold="$(cat "$OUT")"
+		if [[ "$(ls -A "$4" 2> /dev/null)" == '' ]]; then
+			echo "FAIL."
+			echo "Error: '$4' is not made."
+		elif (call_intp "$3") && [ ! -s "$ERR" ]; then
+			if [[ "$(cat "$OUT")" == "$out_cold" ]]; then
+				echo "PASS."
+			else
+				echo "FAIL."
+				echo "Error: The output differs from the 1st run."
+			fi
+		else
+			echo "FAIL."
+			echo "Error:"
+			cat "$ERR"
+		fi
+	else
+		echo "FAIL."
+		echo "Error:"
+		cat "$ERR"
+	fi
+	unset "$1"
+}
+
 # Sanity.
 run_case 'display'
 
 # Documented examples.
-run_case 'load "test.txt"'
+(unset UNILANG_NO_JIT; run_case 'load "test.txt"')
+# NOTE: The results should be same without the JIT.
+run_case_with UNILANG_NO_JIT 1 'load "test.txt"'
+
+
+# Streaming mode.
+run_streaming_case test.txt
+SCRIPT="$(mktemp)"
+echo 'display 1;; display 2' > "$SCRIPT"
+run_streaming_case "$SCRIPT" 12
+echo 'display 1; display 2;' > "$SCRIPT"
+run_streaming_case "$SCRIPT" 12
+# NOTE: The forms before the syntax error are evaluated.
+echo 'display 1; display (2' > "$SCRIPT"
+run_streaming_case "$SCRIPT" 1 error
+rm -f "$SCRIPT"
 
+# Lexical analysis.
+# NOTE: A backslash out of the literals makes the source read by the byte
+#	parsers instead of being scanned in place.
+run_case '$expect (string->symbol "a\\b") $quote a\\b'
+# NOTE: The source locations are counted over the multi-line literals.
+run_error_case $'display "a\nb"; unbound-symbol' \
+	"'unbound-symbol' is at line 2, column 5"
+run_error_case $'display "a\nb"; $quote a\\\\b; unbound-symbol' \
+	"'unbound-symbol' is at line 2, column 18"
+
+# Cache of loaded files.
+CACHE="$(mktemp -d)"
+run_cached_case UNILANG_CACHE "$CACHE" 'load "test.txt"' "$CACHE"
+# NOTE: The file is modified with the same size immediately, which should be
+#	detected even in the same second.
+SRC="$CACHE/src.txt"
+echo '$def! x 1;' > "$SRC"
+UNILANG_CACHE="$CACHE" call_intp "load \"$SRC\"; display x"
+echo '$def! x 2;' > "$SRC"
+echo "Running case with the modified file:" "$SRC"
+if (UNILANG_CACHE="$CACHE" call_intp "load \"$SRC\"; display x") \
+	&& [ ! -s "$ERR" ] && [[ "$(cat "$OUT")" == 2 ]]; then
+	echo "PASS."
+else
+	echo "FAIL."
+	echo "Error:"
+	cat "$ERR"
+fi
+rm -rf "$CACHE"